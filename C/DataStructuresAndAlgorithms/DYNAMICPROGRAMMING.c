@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <time.h>
+#include <pthread.h>
 
 #define MAX(a,b) (((a)>(b))?(a):(b))
 #define MIN(a,b) (((a)<(b))?(a):(b))
@@ -14,6 +16,25 @@ void runLCS();
 void runMatrixChain();
 void runCoinChange();
 void runFloydWarshall();
+void runFloydWarshallBenchmark();
+int floydWarshallTiled(int* dist, int V, int threads);
+void runMatrixChainBenchmark();
+int runChainOnRandomData(const int* p, int n, const int* split, int threads);
+void runCoinChangeBenchmark();
+int* coinMinTable(const int* coins, int n, int V);
+unsigned int* coinWaysTable(const int* coins, int n, int V, unsigned int mod);
+long long coinGreedyCounterexample(const int* coins, int n);
+
+#define FW_INF (INT_MAX / 2) // "No path"; distances saturate at +-FW_INF (see section 7)
+#define COIN_NONE (INT_MAX / 2) // Unreachable amount (see section 9)
+#define COIN_MOD 1000000007u
+
+// Wall-clock seconds for the benchmarks
+static double wallSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
 
 int main() {
     int choice;
@@ -28,7 +49,10 @@ int main() {
         printf("4. Matrix Chain Multiplication\n");
         printf("5. Coin Change Problem (Min Coins)\n");
         printf("6. Floyd-Warshall (Graph Shortest Path)\n");
-        printf("7. Exit\n");
+        printf("7. Floyd-Warshall Benchmark (tiled, multithreaded)\n");
+        printf("8. Matrix Chain Execution Benchmark (blocked GEMM)\n");
+        printf("9. Coin Change Engine Benchmark (min coins, ways)\n");
+        printf("10. Exit\n");
         printf("Enter Choice: ");
         
         if (scanf("%d", &choice) != 1) break;
@@ -40,7 +64,10 @@ int main() {
             case 4: runMatrixChain(); break;
             case 5: runCoinChange(); break;
             case 6: runFloydWarshall(); break;
-            case 7: exit(0);
+            case 7: runFloydWarshallBenchmark(); break;
+            case 8: runMatrixChainBenchmark(); break;
+            case 9: runCoinChangeBenchmark(); break;
+            case 10: exit(0);
             default: printf("Invalid Choice\n");
         }
     }
@@ -178,128 +205,1050 @@ void runLCS() {
 // ====================================================
 // 4. MATRIX CHAIN MULTIPLICATION
 // ====================================================
-// Finds most efficient way to multiply a sequence of matrices
+// Finds most efficient way to multiply a sequence of matrices, then runs
+// that order on real matrices (plan, GEMM engine and pool: section 8).
+//
+// Only pairs i <= j are ever used, so cost and split live in flat
+// triangular arrays of n(n+1)/2 entries (one allocation each, no row
+// pointers). Costs are 64-bit: 3 dimensions of 2000 already overflow int.
+#define CHAIN_IDX(i, j) ((size_t)(j) * ((j) + 1) / 2 + (i))
+
+// Matrix i (0-based) is p[i] x p[i+1]. Fills split[CHAIN_IDX(i, j)] with
+// the k where A_i..A_j splits into (A_i..A_k)(A_k+1..A_j) and returns the
+// minimum number of scalar multiplications, or -1 if out of memory.
+long long matrixChainOrder(const int* p, int n, int* split) {
+    long long* m = (long long*)malloc(CHAIN_IDX(0, n) * sizeof(long long));
+    if (m == NULL) return -1;
+
+    // Cost is zero when multiplying one matrix
+    for (int i = 0; i < n; i++) { m[CHAIN_IDX(i, i)] = 0; split[CHAIN_IDX(i, i)] = i; }
+
+    // L is chain length
+    for (int L = 2; L <= n; L++) {
+        for (int i = 0; i + L - 1 < n; i++) {
+            int j = i + L - 1;
+            long long best = LLONG_MAX;
+            for (int k = i; k < j; k++) {
+                long long q = m[CHAIN_IDX(i, k)] + m[CHAIN_IDX(k + 1, j)] + (long long)p[i] * p[k + 1] * p[j + 1];
+                if (q < best) { best = q; split[CHAIN_IDX(i, j)] = k; }
+            }
+            m[CHAIN_IDX(i, j)] = best;
+        }
+    }
+
+    long long cost = n > 0 ? m[CHAIN_IDX(0, n - 1)] : 0;
+    free(m);
+    return cost;
+}
+
+void printChainOrder(const int* split, int i, int j) {
+    if (i == j) { printf("A%d", i + 1); return; }
+    int k = split[CHAIN_IDX(i, j)];
+    printf("(");
+    printChainOrder(split, i, k);
+    printf(" x ");
+    printChainOrder(split, k + 1, j);
+    printf(")");
+}
+
 void runMatrixChain() {
     int n;
     printf("\n--- Matrix Chain Multiplication ---\n");
     printf("Enter number of matrices: ");
     scanf("%d", &n);
+    if (n <= 0) { printf("Invalid input.\n"); return; }
     
     // Dimensions array size is n+1 because matrix i is p[i-1] x p[i]
     int *p = (int*)malloc((n + 1) * sizeof(int));
+    int *split = (int*)malloc(CHAIN_IDX(0, n) * sizeof(int));
+    if (p == NULL || split == NULL) { printf("Memory allocation failed\n"); free(p); free(split); return; }
     printf("Enter dimensions (array of size %d): ", n + 1);
-    for(int i=0; i<=n; i++) scanf("%d", &p[i]);
+    for(int i=0; i<=n; i++) {
+        if (scanf("%d", &p[i]) != 1 || p[i] <= 0) { printf("Invalid input.\n"); free(p); free(split); return; }
+    }
 
-    // m[i][j] stores minimum number of scalar multiplications
-    int **m = (int**)malloc((n + 1) * sizeof(int*));
-    for(int i=0; i<=n; i++) m[i] = (int*)malloc((n + 1) * sizeof(int));
+    long long cost = matrixChainOrder(p, n, split);
+    if (cost < 0) { printf("Memory allocation failed\n"); free(p); free(split); return; }
 
-    // Cost is zero when multiplying one matrix
-    for (int i = 1; i <= n; i++) m[i][i] = 0;
+    printf(">> Minimum number of multiplications: %lld\n", cost);
+    printf(">> Optimal order: ");
+    printChainOrder(split, 0, n - 1);
+    printf("\n");
 
-    // L is chain length
-    for (int L = 2; L <= n; L++) {
-        for (int i = 1; i <= n - L + 1; i++) {
-            int j = i + L - 1;
-            m[i][j] = INT_MAX;
-            for (int k = i; k <= j - 1; k++) {
-                int q = m[i][k] + m[k + 1][j] + p[i - 1] * p[k] * p[j];
-                if (q < m[i][j])
-                    m[i][j] = q;
-            }
-        }
-    }
-
-    printf(">> Minimum number of multiplications: %d\n", m[1][n]);
+    // Small enough to materialize: run the plan on random matrices
+    int small = 1;
+    for (int i = 0; i <= n; i++) if (p[i] > 2000) small = 0;
+    if (n >= 2 && small) runChainOnRandomData(p, n, split, 1);
 
-    for(int i=0; i<=n; i++) free(m[i]);
-    free(m); free(p);
+    free(split); free(p);
 }
 
 // ====================================================
 // 5. COIN CHANGE PROBLEM (Min Coins)
 // ====================================================
-// Finds minimum coins required to make a specific value V
+// Finds minimum coins required to make a specific value V, the coins
+// used and the number of ways (engine in section 9)
 void runCoinChange() {
     int n, V;
     printf("\n--- Coin Change Problem ---\n");
     printf("Enter number of distinct coin types: ");
     scanf("%d", &n);
+    if (n <= 0) { printf("Invalid input.\n"); return; }
 
     int *coins = (int*)malloc(n * sizeof(int));
     printf("Enter coin values: ");
-    for(int i=0; i<n; i++) scanf("%d", &coins[i]);
+    for(int i=0; i<n; i++) {
+        if (scanf("%d", &coins[i]) != 1 || coins[i] <= 0) { printf("Invalid input.\n"); free(coins); return; }
+    }
 
     printf("Enter Value to make (V): ");
-    scanf("%d", &V);
+    if (scanf("%d", &V) != 1 || V < 0) { printf("Invalid input.\n"); free(coins); return; }
+
+    long long counter = coinGreedyCounterexample(coins, n);
+    if (counter == 0)
+        printf(">> Coin system is canonical: greedy is optimal for every amount\n");
+    else if (counter > 0)
+        printf(">> Coin system is not canonical: greedy fails first at %lld\n", counter);
 
     // table[i] stores min coins for value i
-    int *table = (int*)malloc((V + 1) * sizeof(int));
-
-    // Initialize with infinity
-    table[0] = 0;
-    for (int i = 1; i <= V; i++) table[i] = INT_MAX;
-
-    // Compute minimum coins
-    for (int i = 1; i <= V; i++) {
-        for (int j = 0; j < n; j++) {
-            if (coins[j] <= i) {
-                int sub_res = table[i - coins[j]];
-                if (sub_res != INT_MAX && sub_res + 1 < table[i])
-                    table[i] = sub_res + 1;
+    int *table = coinMinTable(coins, n, V);
+    if (table == NULL) { printf("Memory allocation failed\n"); free(coins); return; }
+
+    if (table[V] >= COIN_NONE)
+        printf(">> Not possible to make value %d with given coins.\n", V);
+    else {
+        printf(">> Minimum coins required: %d\n", table[V]);
+        printf(">> Coins used: ");
+        for (int v = V; v > 0; ) {
+            for (int j = 0; j < n; j++) {
+                if (coins[j] <= v && table[v - coins[j]] == table[v] - 1) {
+                    printf("%d ", coins[j]);
+                    v -= coins[j];
+                    break;
+                }
             }
         }
+        printf("\n");
     }
 
-    if (table[V] == INT_MAX)
-        printf(">> Not possible to make value %d with given coins.\n", V);
-    else
-        printf(">> Minimum coins required: %d\n", table[V]);
+    unsigned int *ways = coinWaysTable(coins, n, V, COIN_MOD);
+    if (ways) printf(">> Number of ways (mod %u): %u\n", COIN_MOD, ways[V]);
 
-    free(coins); free(table);
+    free(coins); free(table); free(ways);
 }
 
 // ====================================================
 // 6. FLOYD-WARSHALL ALGORITHM
 // ====================================================
-// All-Pairs Shortest Path
+// All-Pairs Shortest Path (the tiled engine is in section 7)
 void runFloydWarshall() {
     int V;
     printf("\n--- Floyd-Warshall Algorithm ---\n");
     printf("Enter number of vertices: ");
     scanf("%d", &V);
+    if (V <= 0) { printf("Invalid input.\n"); return; }
 
-    int **dist = (int**)malloc(V * sizeof(int*));
-    for (int i = 0; i < V; i++) dist[i] = (int*)malloc(V * sizeof(int));
+    int *dist = (int*)malloc((size_t)V * V * sizeof(int));
 
     printf("Enter Adjacency Matrix (use 99999 for Infinity):\n");
     for (int i = 0; i < V; i++) {
         for (int j = 0; j < V; j++) {
-            scanf("%d", &dist[i][j]);
+            scanf("%d", &dist[i * V + j]);
+            if (dist[i * V + j] >= INF) dist[i * V + j] = FW_INF;
         }
     }
 
     // The Algorithm
-    for (int k = 0; k < V; k++) {
-        for (int i = 0; i < V; i++) {
-            for (int j = 0; j < V; j++) {
-                if (dist[i][k] + dist[k][j] < dist[i][j])
-                    dist[i][j] = dist[i][k] + dist[k][j];
-            }
-        }
-    }
+    floydWarshallTiled(dist, V, 1);
 
     printf("\n>> Shortest distances between every pair of vertices:\n");
     for (int i = 0; i < V; i++) {
         for (int j = 0; j < V; j++) {
-            if (dist[i][j] >= INF)
+            if (dist[i * V + j] >= FW_INF)
                 printf("%7s", "INF");
             else
-                printf("%7d", dist[i][j]);
+                printf("%7d", dist[i * V + j]);
         }
         printf("\n");
     }
+    for (int i = 0; i < V; i++)
+        if (dist[i * V + i] < 0) { printf(">> Warning: negative cycle through vertex %d\n", i); break; }
 
-    for(int i=0; i<V; i++) free(dist[i]);
     free(dist);
-}
\ No newline at end of file
+}
+
+// ====================================================
+// 7. TILED FLOYD-WARSHALL (Blocked, Parallel, SIMD)
+// ====================================================
+// The triple loop above streams the whole V x V matrix through the cache
+// once per k: at V = 10,000 that is 400 MB, 10,000 times. The blocked
+// version (Venkataraman et al.) cuts the matrix into FW_TILE x FW_TILE
+// tiles and, for each diagonal tile kb:
+//   phase 1: runs plain Floyd-Warshall inside tile (kb, kb)
+//   phase 2: updates the rest of tile row kb and tile column kb from it
+//   phase 3: updates every other tile (i, j) from (i, kb) and (kb, j)
+// Phase 3 is nearly all the work and is a min-plus matrix product of
+// three tiles that sit in L1/L2 (like a DGEMM micro-kernel). Tiles in
+// phases 2 and 3 are independent, so worker threads split them, with a
+// barrier between phases. Tiles are stored contiguously (tile-major) and
+// the j loops run over a whole tile row, which GCC vectorizes (pminsd).
+//
+// Saturating entries: every entry stays in [-FW_INF, FW_INF] with
+// FW_INF = INT_MAX / 2, so the sum of any two still fits in an int. min()
+// keeps the top side, and each relaxation is clamped at -FW_INF (one
+// pmaxsd) because a negative cycle otherwise drives its distances down by
+// a cycle's weight per pass until they wrap past INT_MIN. No branch in
+// the inner loop. With negative edges an unreachable entry can drift just
+// below FW_INF; results >= FW_INF / 2 are reported as FW_INF, which is
+// exact as long as |path lengths| < FW_INF / 2. With a negative cycle the
+// distances through it are meaningless (only bounded): the cycle shows up
+// as a negative diagonal entry, which is all callers should rely on.
+
+#define FW_TILE 64
+
+struct FwShared {
+    int* tiles;          // nb * nb tiles of FW_TILE * FW_TILE ints
+    int nb, threads;
+    pthread_barrier_t barrier;
+};
+
+struct FwJob {
+    struct FwShared* fw;
+    int id;
+};
+
+static int* fwTile(const struct FwShared* fw, int bi, int bj) {
+    return fw->tiles + ((size_t)bi * fw->nb + bj) * FW_TILE * FW_TILE;
+}
+
+// Phases 1 and 2: C may be A or B, so k stays the outer loop as in the
+// textbook version (row/column k does not change while pivoting on k)
+static void fwTilePivot(int* C, const int* A, const int* B) {
+    for (int k = 0; k < FW_TILE; k++) {
+        const int* b = B + k * FW_TILE;
+        for (int i = 0; i < FW_TILE; i++) {
+            int a = A[i * FW_TILE + k];
+            int* c = C + i * FW_TILE;
+            for (int j = 0; j < FW_TILE; j++) {
+                int s = a + b[j];
+                s = s < c[j] ? s : c[j];
+                c[j] = s > -FW_INF ? s : -FW_INF;
+            }
+        }
+    }
+}
+
+// Phase 3: C = min(C, A (min,+) B) with three distinct tiles. A and B are
+// final for this round, so any loop order is valid; i-k-j keeps one row
+// of C hot and streams B.
+static void fwTileMinPlus(int* restrict C, const int* restrict A, const int* restrict B) {
+    for (int i = 0; i < FW_TILE; i++) {
+        int* restrict c = C + i * FW_TILE;
+        for (int k = 0; k < FW_TILE; k++) {
+            int a = A[i * FW_TILE + k];
+            const int* restrict b = B + k * FW_TILE;
+            for (int j = 0; j < FW_TILE; j++) {
+                int s = a + b[j];
+                s = s < c[j] ? s : c[j];
+                c[j] = s > -FW_INF ? s : -FW_INF;
+            }
+        }
+    }
+}
+
+static void* fwWorker(void* arg) {
+    struct FwJob* job = (struct FwJob*)arg;
+    struct FwShared* fw = job->fw;
+    int nb = fw->nb;
+
+    for (int kb = 0; kb < nb; kb++) {
+        int* diag = fwTile(fw, kb, kb);
+        if (job->id == 0) fwTilePivot(diag, diag, diag);
+        pthread_barrier_wait(&fw->barrier);
+
+        // Phase 2: task t < nb - 1 is a row tile, the rest column tiles
+        for (int t = job->id; t < 2 * (nb - 1); t += fw->threads) {
+            int other = t % (nb - 1);
+            if (other >= kb) other++; // Skip the diagonal
+            if (t < nb - 1) {
+                int* row = fwTile(fw, kb, other);
+                fwTilePivot(row, diag, row);
+            } else {
+                int* col = fwTile(fw, other, kb);
+                fwTilePivot(col, col, diag);
+            }
+        }
+        pthread_barrier_wait(&fw->barrier);
+
+        // Phase 3: all tiles off row kb and column kb
+        for (int t = job->id; t < (nb - 1) * (nb - 1); t += fw->threads) {
+            int bi = t / (nb - 1), bj = t % (nb - 1);
+            if (bi >= kb) bi++;
+            if (bj >= kb) bj++;
+            fwTileMinPlus(fwTile(fw, bi, bj), fwTile(fw, bi, kb), fwTile(fw, kb, bj));
+        }
+        pthread_barrier_wait(&fw->barrier);
+    }
+    return NULL;
+}
+
+// All-pairs shortest paths in place on dist[V * V] (row-major, FW_INF =
+// no edge). Returns 0, or -1 if out of memory (dist untouched).
+int floydWarshallTiled(int* dist, int V, int threads) {
+    struct FwShared fw;
+    int nb = (V + FW_TILE - 1) / FW_TILE;
+    if (V <= 0) return 0;
+    if (threads < 1) threads = 1;
+
+    fw.nb = nb;
+    fw.threads = threads;
+    fw.tiles = (int*)aligned_alloc(64, (size_t)nb * nb * FW_TILE * FW_TILE * sizeof(int));
+    pthread_t* tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    struct FwJob* jobs = (struct FwJob*)malloc(threads * sizeof(struct FwJob));
+    if (!fw.tiles || !tids || !jobs) { free(fw.tiles); free(tids); free(jobs); return -1; }
+
+    // Pack into tiles; padding vertices are isolated (FW_INF, 0 on the diagonal)
+    for (int i = 0; i < nb * FW_TILE; i++) {
+        for (int j = 0; j < nb * FW_TILE; j++) {
+            int v = (i < V && j < V) ? dist[(size_t)i * V + j] : (i == j ? 0 : FW_INF);
+            fwTile(&fw, i / FW_TILE, j / FW_TILE)[(i % FW_TILE) * FW_TILE + j % FW_TILE] = MAX(MIN(v, FW_INF), -FW_INF);
+        }
+    }
+
+    pthread_barrier_init(&fw.barrier, NULL, threads);
+    for (int t = 0; t < threads; t++) {
+        jobs[t].fw = &fw;
+        jobs[t].id = t;
+        pthread_create(&tids[t], NULL, fwWorker, &jobs[t]);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    pthread_barrier_destroy(&fw.barrier);
+
+    for (int i = 0; i < V; i++) {
+        for (int j = 0; j < V; j++) {
+            int v = fwTile(&fw, i / FW_TILE, j / FW_TILE)[(i % FW_TILE) * FW_TILE + j % FW_TILE];
+            dist[(size_t)i * V + j] = (v >= FW_INF / 2) ? FW_INF : v;
+        }
+    }
+    free(fw.tiles);
+    free(tids);
+    free(jobs);
+    return 0;
+}
+
+// Textbook triple loop on the same layout, for checking and timing
+// (entries in [-FW_INF, FW_INF], clamped at -FW_INF like the tiled one)
+void floydWarshallNaive(int* dist, int V) {
+    for (int k = 0; k < V; k++) {
+        for (int i = 0; i < V; i++) {
+            int a = dist[(size_t)i * V + k];
+            if (a >= FW_INF) continue;
+            for (int j = 0; j < V; j++) {
+                int b = dist[(size_t)k * V + j];
+                if (b < FW_INF && a + b < dist[(size_t)i * V + j])
+                    dist[(size_t)i * V + j] = MAX(a + b, -FW_INF);
+            }
+        }
+    }
+}
+
+// Random dense graph (about 1 edge in 4 missing), tiled vs textbook
+void runFloydWarshallBenchmark() {
+    int V, threads;
+    printf("\n--- Tiled Floyd-Warshall Benchmark ---\n");
+    printf("Enter number of vertices (e.g. 10000): ");
+    if (scanf("%d", &V) != 1 || V <= 0) { printf("Invalid input.\n"); return; }
+    printf("Enter number of threads: ");
+    if (scanf("%d", &threads) != 1 || threads <= 0) threads = 1;
+
+    size_t cells = (size_t)V * V;
+    int* dist = (int*)malloc(cells * sizeof(int));
+    int* check = NULL;
+    if (dist == NULL) { printf("Memory allocation failed\n"); return; }
+    unsigned int seed = 42;
+    for (size_t c = 0; c < cells; c++) {
+        seed = seed * 1103515245u + 12345u;
+        dist[c] = ((seed >> 16) % 4 == 0) ? FW_INF : 1 + (int)((seed >> 8) % 1000);
+    }
+    for (int i = 0; i < V; i++) dist[(size_t)i * V + i] = 0;
+
+    // The textbook loop takes V^3 steps: only compare on small graphs
+    if (V <= 2000 && (check = (int*)malloc(cells * sizeof(int))) != NULL) {
+        memcpy(check, dist, cells * sizeof(int));
+        double start = wallSeconds();
+        floydWarshallNaive(check, V);
+        printf(">> Textbook triple loop: %.2f s\n", wallSeconds() - start);
+    }
+
+    double start = wallSeconds();
+    if (floydWarshallTiled(dist, V, threads) != 0) { printf("Memory allocation failed\n"); free(dist); free(check); return; }
+    double secs = wallSeconds() - start;
+    printf(">> Tiled, %d thread(s):   %.2f s (%.1f G relaxations/s)", threads, secs, (double)V * V * V / secs / 1e9);
+    if (check) printf("%s", memcmp(check, dist, cells * sizeof(int)) == 0 ? " ok" : " MISMATCH");
+    printf("\n");
+    free(dist);
+    free(check);
+}
+
+// ====================================================
+// 8. MATRIX CHAIN EXECUTION (Blocked GEMM, Plan, Pool)
+// ====================================================
+// Section 4 finds the order; this section runs it. The split table turns
+// into a plan of n - 1 products in post-order (each step reads two inputs
+// or earlier results). Temporaries come from a pool of freed buffers
+// (best fit by capacity), so a long chain reuses a few allocations
+// instead of mallocing one result per step.
+//
+// The products use a GotoBLAS-style GEMM: C is split into GEMM_NC column
+// blocks, the shared dimension into GEMM_KC slices, and A into GEMM_MC row
+// blocks. Each slice of B (KC x NC, L3) and block of A (MC x KC, L2) is
+// packed into panels so the micro-kernel reads both operands with unit
+// stride and keeps a 4 x GEMM_NR block of C in eight vector registers:
+// 4 x 8 in ymm with -mavx (FMA with -mfma), 4 x 4 in xmm otherwise.
+// Threads take disjoint row slabs of C, each packing its own copy of B.
+
+#ifdef __AVX__
+#define GEMM_VEC 4
+#else
+#define GEMM_VEC 2
+#endif
+#define GEMM_MR 4
+#define GEMM_NR (2 * GEMM_VEC)
+#define GEMM_MC 128
+#define GEMM_KC 256
+#define GEMM_NC 1024
+
+typedef double GemmVec __attribute__((vector_size(GEMM_VEC * sizeof(double))));
+
+struct Matrix {
+    int rows, cols;
+    size_t capacity;     // doubles allocated, >= rows * cols (pool reuse)
+    double* data;        // row-major, 64-byte aligned
+};
+
+struct Matrix* matrixCreate(int rows, int cols) {
+    struct Matrix* M = (struct Matrix*)malloc(sizeof(struct Matrix));
+    size_t bytes = ((size_t)rows * cols * sizeof(double) + 63) / 64 * 64;
+    if (M == NULL) return NULL;
+    M->data = (double*)aligned_alloc(64, bytes ? bytes : 64);
+    if (M->data == NULL) { free(M); return NULL; }
+    M->rows = rows;
+    M->cols = cols;
+    M->capacity = bytes / sizeof(double);
+    return M;
+}
+
+void matrixFree(struct Matrix* M) {
+    if (M == NULL) return;
+    free(M->data);
+    free(M);
+}
+
+// Packs rows [0, mc) x columns [0, kc) of A (leading dimension lda) into
+// panels of GEMM_MR rows, stored k-major; short panels are zero-padded
+static void gemmPackA(double* restrict dst, const double* restrict A, int lda, int mc, int kc) {
+    for (int ir = 0; ir < mc; ir += GEMM_MR) {
+        int mr = MIN(GEMM_MR, mc - ir);
+        for (int k = 0; k < kc; k++) {
+            for (int r = 0; r < GEMM_MR; r++)
+                dst[r] = r < mr ? A[(size_t)(ir + r) * lda + k] : 0.0;
+            dst += GEMM_MR;
+        }
+    }
+}
+
+// Same for a kc x nc slice of B, in panels of GEMM_NR columns
+static void gemmPackB(double* restrict dst, const double* restrict B, int ldb, int kc, int nc) {
+    for (int jr = 0; jr < nc; jr += GEMM_NR) {
+        int nr = MIN(GEMM_NR, nc - jr);
+        for (int k = 0; k < kc; k++) {
+            const double* b = B + (size_t)k * ldb + jr;
+            for (int j = 0; j < GEMM_NR; j++) dst[j] = j < nr ? b[j] : 0.0;
+            dst += GEMM_NR;
+        }
+    }
+}
+
+// C[mr x nr] += Apanel * Bpanel over kc. Spelled out so the eight
+// accumulators stay in registers.
+static void gemmMicroKernel(int kc, const double* restrict a, const double* restrict b,
+                            double* restrict C, int ldc, int mr, int nr) {
+    GemmVec c00 = {0}, c01 = {0}, c10 = {0}, c11 = {0};
+    GemmVec c20 = {0}, c21 = {0}, c30 = {0}, c31 = {0};
+
+    for (int k = 0; k < kc; k++) {
+        GemmVec b0 = *(const GemmVec*)b, b1 = *(const GemmVec*)(b + GEMM_VEC);
+        c00 += a[0] * b0; c01 += a[0] * b1;
+        c10 += a[1] * b0; c11 += a[1] * b1;
+        c20 += a[2] * b0; c21 += a[2] * b1;
+        c30 += a[3] * b0; c31 += a[3] * b1;
+        a += GEMM_MR;
+        b += GEMM_NR;
+    }
+
+    GemmVec acc[GEMM_MR][2] = { { c00, c01 }, { c10, c11 }, { c20, c21 }, { c30, c31 } };
+    if (mr == GEMM_MR && nr == GEMM_NR) {
+        for (int r = 0; r < GEMM_MR; r++) {
+            double* c = C + (size_t)r * ldc;
+            GemmVec lo, hi;
+            memcpy(&lo, c, sizeof lo);
+            memcpy(&hi, c + GEMM_VEC, sizeof hi);
+            lo += acc[r][0];
+            hi += acc[r][1];
+            memcpy(c, &lo, sizeof lo);
+            memcpy(c + GEMM_VEC, &hi, sizeof hi);
+        }
+    } else {
+        for (int r = 0; r < mr; r++)
+            for (int j = 0; j < nr; j++)
+                C[(size_t)r * ldc + j] += acc[r][j / GEMM_VEC][j % GEMM_VEC];
+    }
+}
+
+struct GemmJob {
+    const struct Matrix *A, *B;
+    struct Matrix* C;
+    int rowBegin, rowEnd;
+    int failed;
+};
+
+// C[rowBegin..rowEnd) = A[rowBegin..rowEnd) * B
+static void* gemmWorker(void* arg) {
+    struct GemmJob* job = (struct GemmJob*)arg;
+    const struct Matrix *A = job->A, *B = job->B;
+    struct Matrix* C = job->C;
+    int K = A->cols, N = B->cols;
+    double* packA = (double*)aligned_alloc(64, GEMM_MC * GEMM_KC * sizeof(double));
+    double* packB = (double*)aligned_alloc(64, GEMM_KC * GEMM_NC * sizeof(double));
+    if (packA == NULL || packB == NULL) { free(packA); free(packB); job->failed = 1; return NULL; }
+
+    memset(C->data + (size_t)job->rowBegin * N, 0, (size_t)(job->rowEnd - job->rowBegin) * N * sizeof(double));
+
+    for (int jc = 0; jc < N; jc += GEMM_NC) {
+        int nc = MIN(GEMM_NC, N - jc);
+        for (int pc = 0; pc < K; pc += GEMM_KC) {
+            int kc = MIN(GEMM_KC, K - pc);
+            gemmPackB(packB, B->data + (size_t)pc * N + jc, N, kc, nc);
+            for (int ic = job->rowBegin; ic < job->rowEnd; ic += GEMM_MC) {
+                int mc = MIN(GEMM_MC, job->rowEnd - ic);
+                gemmPackA(packA, A->data + (size_t)ic * K + pc, K, mc, kc);
+                for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                    for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                        gemmMicroKernel(kc, packA + (size_t)ir * kc, packB + (size_t)jr * kc,
+                                        C->data + (size_t)(ic + ir) * N + jc + jr, N,
+                                        MIN(GEMM_MR, mc - ir), MIN(GEMM_NR, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+    free(packA);
+    free(packB);
+    return NULL;
+}
+
+// C = A * B (C must already be A->rows x B->cols and distinct from A and
+// B). Returns 0, -1 on a dimension mismatch or if out of memory.
+int matrixMultiply(struct Matrix* C, const struct Matrix* A, const struct Matrix* B, int threads) {
+    int M = A->rows;
+    if (A->cols != B->rows || C->rows != M || C->cols != B->cols) return -1;
+    if (M == 0 || C->cols == 0) return 0;
+
+    // A thread only pays off with a few row blocks of its own
+    long long work = (long long)M * A->cols * B->cols;
+    if (threads < 1 || work < (1LL << 21)) threads = 1;
+    threads = MIN(threads, (M + GEMM_MR - 1) / GEMM_MR);
+
+    struct GemmJob* jobs = (struct GemmJob*)malloc(threads * sizeof(struct GemmJob));
+    pthread_t* tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    if (jobs == NULL || tids == NULL) { free(jobs); free(tids); return -1; }
+
+    // Slabs are whole micro-panels so no two threads share a row of C
+    int slab = ((M + threads - 1) / threads + GEMM_MR - 1) / GEMM_MR * GEMM_MR;
+    int failed = 0;
+    for (int t = 0; t < threads; t++) {
+        jobs[t] = (struct GemmJob){ A, B, C, MIN(M, t * slab), MIN(M, (t + 1) * slab), 0 };
+        if (t > 0) pthread_create(&tids[t], NULL, gemmWorker, &jobs[t]);
+    }
+    gemmWorker(&jobs[0]); // The calling thread takes the first slab
+    for (int t = 1; t < threads; t++) pthread_join(tids[t], NULL);
+    for (int t = 0; t < threads; t++) failed |= jobs[t].failed;
+    free(jobs);
+    free(tids);
+    return failed ? -1 : 0;
+}
+
+// Textbook i-k-j product, for checking and timing
+void matrixMultiplyNaive(struct Matrix* C, const struct Matrix* A, const struct Matrix* B) {
+    int M = A->rows, K = A->cols, N = B->cols;
+    memset(C->data, 0, (size_t)M * N * sizeof(double));
+    for (int i = 0; i < M; i++) {
+        double* c = C->data + (size_t)i * N;
+        for (int k = 0; k < K; k++) {
+            double a = A->data[(size_t)i * K + k];
+            const double* b = B->data + (size_t)k * N;
+            for (int j = 0; j < N; j++) c[j] += a * b[j];
+        }
+    }
+}
+
+// --- Buffer pool for chain temporaries ---
+struct MatrixPool {
+    struct Matrix** idle;   // released buffers, ready for reuse
+    int count, cap;
+    int allocations, reuses;
+};
+
+// Smallest idle buffer that fits rows x cols, else a new one
+struct Matrix* poolAcquire(struct MatrixPool* pool, int rows, int cols) {
+    size_t need = (size_t)rows * cols;
+    int best = -1;
+    for (int i = 0; i < pool->count; i++) {
+        if (pool->idle[i]->capacity >= need && (best < 0 || pool->idle[i]->capacity < pool->idle[best]->capacity))
+            best = i;
+    }
+    if (best < 0) {
+        struct Matrix* M = matrixCreate(rows, cols);
+        if (M) pool->allocations++;
+        return M;
+    }
+    struct Matrix* M = pool->idle[best];
+    pool->idle[best] = pool->idle[--pool->count];
+    M->rows = rows;
+    M->cols = cols;
+    pool->reuses++;
+    return M;
+}
+
+void poolRelease(struct MatrixPool* pool, struct Matrix* M) {
+    if (pool->count == pool->cap) {
+        int cap = pool->cap ? pool->cap * 2 : 8;
+        struct Matrix** grown = (struct Matrix**)realloc(pool->idle, cap * sizeof(struct Matrix*));
+        if (grown == NULL) { matrixFree(M); return; }
+        pool->idle = grown;
+        pool->cap = cap;
+    }
+    pool->idle[pool->count++] = M;
+}
+
+void poolDestroy(struct MatrixPool* pool) {
+    for (int i = 0; i < pool->count; i++) matrixFree(pool->idle[i]);
+    free(pool->idle);
+    pool->idle = NULL;
+    pool->count = pool->cap = 0;
+}
+
+// --- Execution plan ---
+// Operand ids: 0..n-1 are the input matrices, n + s is the result of step s
+struct ChainStep {
+    int left, right;
+    int rows, cols;
+};
+
+struct ChainPlan {
+    int n;
+    struct ChainStep* steps;   // n - 1 products, operands before their users
+    int count;
+};
+
+static int chainEmit(struct ChainPlan* plan, const int* p, const int* split, int i, int j) {
+    if (i == j) return i;
+    int k = split[CHAIN_IDX(i, j)];
+    int left = chainEmit(plan, p, split, i, k);
+    int right = chainEmit(plan, p, split, k + 1, j);
+    plan->steps[plan->count] = (struct ChainStep){ left, right, p[i], p[j + 1] };
+    return plan->n + plan->count++;
+}
+
+// Plan for the order in split (from matrixChainOrder). Returns 0, or -1
+// if out of memory.
+int chainPlanBuild(struct ChainPlan* plan, const int* p, int n, const int* split) {
+    plan->n = n;
+    plan->count = 0;
+    plan->steps = (struct ChainStep*)malloc(MAX(n - 1, 1) * sizeof(struct ChainStep));
+    if (plan->steps == NULL) return -1;
+    chainEmit(plan, p, split, 0, n - 1);
+    return 0;
+}
+
+// Multiplies inputs[0..n) (n >= 2) in plan order. Intermediates go back to
+// the pool as soon as their one consumer has run; the returned product
+// belongs to the caller (poolRelease or matrixFree). NULL on failure.
+struct Matrix* chainExecute(const struct ChainPlan* plan, struct Matrix** inputs,
+                            struct MatrixPool* pool, int threads) {
+    int n = plan->n;
+    struct Matrix** result = (struct Matrix**)calloc(plan->count, sizeof(struct Matrix*));
+    struct Matrix* product = NULL;
+    if (result == NULL || plan->count == 0) { free(result); return NULL; }
+
+    for (int s = 0; s < plan->count; s++) {
+        const struct ChainStep* st = &plan->steps[s];
+        struct Matrix* A = st->left < n ? inputs[st->left] : result[st->left - n];
+        struct Matrix* B = st->right < n ? inputs[st->right] : result[st->right - n];
+
+        result[s] = poolAcquire(pool, st->rows, st->cols);
+        if (result[s] == NULL || matrixMultiply(result[s], A, B, threads) != 0) break;
+
+        if (st->left >= n) { poolRelease(pool, A); result[st->left - n] = NULL; }
+        if (st->right >= n) { poolRelease(pool, B); result[st->right - n] = NULL; }
+        if (s == plan->count - 1) { product = result[s]; result[s] = NULL; }
+    }
+
+    // Only left over after a failure
+    for (int s = 0; s < plan->count; s++) if (result[s]) poolRelease(pool, result[s]);
+    free(result);
+    return product;
+}
+
+static void matrixRandom(struct Matrix* M, unsigned int* seed) {
+    for (size_t c = 0; c < (size_t)M->rows * M->cols; c++) {
+        *seed = *seed * 1103515245u + 12345u;
+        M->data[c] = (double)((*seed >> 8) % 2001) / 1000.0 - 1.0;
+    }
+}
+
+// Largest |X - Y| relative to the largest |Y|
+static double matrixRelativeError(const struct Matrix* X, const struct Matrix* Y) {
+    double diff = 0, scale = 0;
+    for (size_t c = 0; c < (size_t)Y->rows * Y->cols; c++) {
+        double e = X->data[c] - Y->data[c];
+        diff = MAX(diff, e < 0 ? -e : e);
+        scale = MAX(scale, Y->data[c] < 0 ? -Y->data[c] : Y->data[c]);
+    }
+    return scale > 0 ? diff / scale : diff;
+}
+
+// Runs the optimal plan and the left-to-right order on the same random
+// chain and reports time, pool use and agreement. Returns 0, -1 on failure.
+int runChainOnRandomData(const int* p, int n, const int* split, int threads) {
+    struct Matrix** inputs = (struct Matrix**)calloc(n, sizeof(struct Matrix*));
+    int* leftToRight = (int*)malloc(CHAIN_IDX(0, n) * sizeof(int));
+    struct ChainPlan best = { 0 }, naive = { 0 };
+    struct MatrixPool pool = { 0 };
+    struct Matrix *fast = NULL, *slow = NULL;
+    unsigned int seed = 7;
+    int status = -1;
+
+    if (inputs == NULL || leftToRight == NULL) goto done;
+    for (int i = 0; i < n; i++) {
+        if ((inputs[i] = matrixCreate(p[i], p[i + 1])) == NULL) goto done;
+        matrixRandom(inputs[i], &seed);
+    }
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i <= j; i++) leftToRight[CHAIN_IDX(i, j)] = MAX(i, j - 1);
+    if (chainPlanBuild(&best, p, n, split) != 0 || chainPlanBuild(&naive, p, n, leftToRight) != 0) goto done;
+
+    double start = wallSeconds();
+    fast = chainExecute(&best, inputs, &pool, threads);
+    double bestSecs = wallSeconds() - start;
+    if (fast == NULL) goto done;
+    printf(">> Optimal order:       %.3f s, %d products, %d buffers allocated, %d reused\n",
+           bestSecs, best.count, pool.allocations, pool.reuses);
+
+    start = wallSeconds();
+    slow = chainExecute(&naive, inputs, &pool, threads);
+    double naiveSecs = wallSeconds() - start;
+    if (slow == NULL) goto done;
+    printf(">> Left-to-right order: %.3f s (relative difference %.1e)\n",
+           naiveSecs, matrixRelativeError(fast, slow));
+    status = 0;
+
+done:
+    if (status != 0) printf("Memory allocation failed\n");
+    matrixFree(fast);
+    matrixFree(slow);
+    poolDestroy(&pool);
+    free(best.steps);
+    free(naive.steps);
+    if (inputs) for (int i = 0; i < n; i++) matrixFree(inputs[i]);
+    free(inputs);
+    free(leftToRight);
+    return status;
+}
+
+// GEMM throughput on a square product, then a fixed chain where the order
+// matters (left to right costs about 50x the optimal plan)
+void runMatrixChainBenchmark() {
+    static const int dims[] = { 1500, 40, 1800, 30, 1200, 1600, 20, 1400, 1000 };
+    int n = (int)(sizeof(dims) / sizeof(dims[0])) - 1, N, threads;
+    unsigned int seed = 1;
+
+    printf("\n--- Matrix Chain Execution Benchmark ---\n");
+    printf("Enter size of the square GEMM test (e.g. 1024): ");
+    if (scanf("%d", &N) != 1 || N <= 0) { printf("Invalid input.\n"); return; }
+    printf("Enter number of threads: ");
+    if (scanf("%d", &threads) != 1 || threads <= 0) threads = 1;
+
+    struct Matrix *A = matrixCreate(N, N), *B = matrixCreate(N, N);
+    struct Matrix *C = matrixCreate(N, N), *R = matrixCreate(N, N);
+    if (A && B && C && R) {
+        double flops = 2.0 * N * N * N;
+        matrixRandom(A, &seed);
+        matrixRandom(B, &seed);
+        double start = wallSeconds();
+        matrixMultiplyNaive(R, A, B);
+        double naiveSecs = wallSeconds() - start;
+        start = wallSeconds();
+        matrixMultiply(C, A, B, threads);
+        double secs = wallSeconds() - start;
+        printf(">> Textbook i-k-j:       %.3f s (%.1f GFLOP/s)\n", naiveSecs, flops / naiveSecs / 1e9);
+        printf(">> Blocked, %d thread(s): %.3f s (%.1f GFLOP/s, relative difference %.1e)\n",
+               threads, secs, flops / secs / 1e9, matrixRelativeError(C, R));
+    } else {
+        printf("Memory allocation failed\n");
+    }
+    matrixFree(A); matrixFree(B); matrixFree(C); matrixFree(R);
+
+    int* split = (int*)malloc(CHAIN_IDX(0, n) * sizeof(int));
+    if (split == NULL) { printf("Memory allocation failed\n"); return; }
+    long long naiveCost = 0;
+    for (int k = 1; k < n; k++) naiveCost += (long long)dims[0] * dims[k] * dims[k + 1];
+    printf("\nChain of %d matrices: ", n);
+    for (int i = 0; i < n; i++) printf("%dx%d ", dims[i], dims[i + 1]);
+    printf("\n>> Multiplications: %lld optimal, %lld left to right\n", matrixChainOrder(dims, n, split), naiveCost);
+    printf(">> Optimal order: ");
+    printChainOrder(split, 0, n - 1);
+    printf("\n");
+    runChainOnRandomData(dims, n, split, threads);
+    free(split);
+}
+
+// ====================================================
+// 9. COIN CHANGE ENGINE (Min Coins, Ways, Canonical Check)
+// ====================================================
+// Unbounded coin change over amounts up to ~1e8 with hundreds of coins.
+// Both tables are 1D and updated one coin at a time:
+//   min:  t[i] = min(t[i], t[i - c] + 1)
+//   ways: w[i] = (w[i] + w[i - c]) mod p
+// For coin c, t[i] only depends on t[i - c], so the range splits into
+// strided windows of c entries that read the previous window: inside a
+// window there is no dependency, so it is processed COIN_LANES entries at
+// a time with GCC vector extensions (GCC does not vectorize these
+// variable-length loops at -O2 by itself). Coins below COIN_SCALAR_MAX
+// give windows too short for that and keep the scalar loop.
+//
+// The min table is also blocked by amount: every coin is applied to one
+// COIN_BLOCK of the table before moving on, so the destination stays in
+// L2 instead of streaming the whole table once per coin. This is valid
+// because entries below the block are already final, and min-coins does
+// not care in which order coins are applied. The ways count does (it
+// counts multisets only if coins are applied one at a time over the whole
+// range), so it keeps the coin-outer order.
+
+#define COIN_BLOCK (1 << 14)
+#define COIN_SCALAR_MAX 16
+#ifdef __AVX2__
+#define COIN_LANES 8
+#else
+#define COIN_LANES 4
+#endif
+
+typedef int CoinVec __attribute__((vector_size(COIN_LANES * sizeof(int))));
+typedef unsigned int CoinUVec __attribute__((vector_size(COIN_LANES * sizeof(int))));
+
+static void coinMinWindow(int* restrict dst, const int* restrict src, int len) {
+    int j = 0;
+    for (; j + COIN_LANES <= len; j += COIN_LANES) {
+        CoinVec a, s;
+        memcpy(&a, dst + j, sizeof a);
+        memcpy(&s, src + j, sizeof s);
+        s += 1;
+        a = s ^ ((a ^ s) & (a < s));   // min(a, s) without a branch
+        memcpy(dst + j, &a, sizeof a);
+    }
+    for (; j < len; j++) {
+        int s = src[j] + 1;
+        dst[j] = s < dst[j] ? s : dst[j];
+    }
+}
+
+static void coinAddWindow(unsigned int* restrict dst, const unsigned int* restrict src, int len, unsigned int mod) {
+    CoinUVec m = (CoinUVec){ 0 } + mod;
+    int j = 0;
+    for (; j + COIN_LANES <= len; j += COIN_LANES) {
+        CoinUVec a, b;
+        memcpy(&a, dst + j, sizeof a);
+        memcpy(&b, src + j, sizeof b);
+        a += b;
+        a -= m & (CoinUVec)(a >= m);
+        memcpy(dst + j, &a, sizeof a);
+    }
+    for (; j < len; j++) {
+        unsigned int s = dst[j] + src[j];
+        dst[j] = s >= mod ? s - mod : s;
+    }
+}
+
+static int compareCoins(const void* a, const void* b) {
+    return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b);
+}
+
+// Sorted, distinct coins in [1, V]; returns how many (or -1 if out of memory)
+static int coinPrepare(const int* coins, int n, int V, int** out) {
+    int* c = (int*)malloc(MAX(n, 1) * sizeof(int));
+    int m = 0;
+    if (c == NULL) return -1;
+    for (int i = 0; i < n; i++) if (coins[i] >= 1 && coins[i] <= V) c[m++] = coins[i];
+    qsort(c, m, sizeof(int), compareCoins);
+    int k = 0;
+    for (int i = 0; i < m; i++) if (k == 0 || c[i] != c[k - 1]) c[k++] = c[i];
+    *out = c;
+    return k;
+}
+
+// table[0..V]: minimum number of coins for each amount, COIN_NONE where
+// the amount cannot be made. NULL if out of memory (or V < 0, V = INT_MAX).
+int* coinMinTable(const int* coins, int n, int V) {
+    if (V < 0 || V == INT_MAX) return NULL;
+    int *c, *t = (int*)malloc(((size_t)V + 1) * sizeof(int));
+    int m = coinPrepare(coins, n, V, &c);
+    if (t == NULL || m < 0) { free(t); if (m >= 0) free(c); return NULL; }
+
+    t[0] = 0;
+    for (int i = 1; i <= V; i++) t[i] = COIN_NONE;
+
+    for (int L = 1, R; L <= V; L = R) {
+        R = (int)MIN((long long)V + 1, (long long)L + COIN_BLOCK);
+        for (int k = 0; k < m; k++) {
+            int coin = c[k], start = MAX(L, coin);
+            if (coin < COIN_SCALAR_MAX) {
+                for (int i = start; i < R; i++) {
+                    int s = t[i - coin] + 1;
+                    if (s < t[i]) t[i] = s;
+                }
+                continue;
+            }
+            for (int i = start; i < R; i += coin)
+                coinMinWindow(t + i, t + i - coin, MIN(coin, R - i));
+        }
+    }
+    free(c);
+    return t;
+}
+
+// ways[0..V]: number of multisets of coins summing to each amount, modulo
+// mod (1 <= mod <= 2^31). NULL if out of memory (or V < 0, V = INT_MAX).
+unsigned int* coinWaysTable(const int* coins, int n, int V, unsigned int mod) {
+    if (V < 0 || V == INT_MAX) return NULL;
+    int* c;
+    unsigned int* w = (unsigned int*)calloc((size_t)V + 1, sizeof(unsigned int));
+    int m = coinPrepare(coins, n, V, &c);
+    if (w == NULL || m < 0) { free(w); if (m >= 0) free(c); return NULL; }
+
+    w[0] = 1 % mod;
+    for (int k = 0; k < m; k++) {
+        int coin = c[k];
+        if (coin < COIN_SCALAR_MAX) {
+            for (int i = coin; i <= V; i++) {
+                unsigned int s = w[i] + w[i - coin];
+                w[i] = s >= mod ? s - mod : s;
+            }
+            continue;
+        }
+        for (long long i = coin; i <= V; i += coin)
+            coinAddWindow(w + i, w + i - coin, (int)MIN((long long)coin, V + 1 - i), mod);
+    }
+    free(c);
+    return w;
+}
+
+// Greedy coin count for x with coins sorted descending
+static long long coinGreedyCount(const int* desc, int m, long long x) {
+    long long count = 0;
+    for (int i = 0; i < m && x > 0; i++) {
+        count += x / desc[i];
+        x %= desc[i];
+    }
+    return count;
+}
+
+// Pearson's O(n^3) test (Pearson 2005, "A polynomial-time algorithm for
+// the change-making problem"). With coins c1 > c2 > ... > cn = 1, the
+// smallest amount where greedy is not optimal (if any) is, for some
+// i <= j: take the greedy representation of c(i-1) - 1, keep its counts of
+// c1..c(j-1), add one to the count of cj and drop the rest. Returns that
+// smallest amount, 0 if greedy is always optimal, -1 if there is no 1 coin
+// (greedy can then miss amounts that are makeable) or out of memory.
+long long coinGreedyCounterexample(const int* coins, int n) {
+    int* desc = NULL;
+    int m = coinPrepare(coins, n, INT_MAX, &desc);
+    if (m < 0) return -1;
+    if (m == 0 || desc[0] != 1) { free(desc); return -1; }
+    for (int i = 0; i < m / 2; i++) { int x = desc[i]; desc[i] = desc[m - 1 - i]; desc[m - 1 - i] = x; }
+
+    long long best = 0;
+    long long* greedy = (long long*)malloc(m * sizeof(long long));
+    if (greedy == NULL) { free(desc); return -1; }
+
+    for (int i = 1; i < m; i++) {
+        // Greedy representation of desc[i-1] - 1
+        long long x = desc[i - 1] - 1;
+        for (int k = 0; k < m; k++) { greedy[k] = x / desc[k]; x %= desc[k]; }
+
+        long long value = 0, count = 0;   // Counts of desc[0..j-1] kept so far
+        for (int j = i; j < m; j++) {
+            if (j > 0) { value += greedy[j - 1] * desc[j - 1]; count += greedy[j - 1]; }
+            long long w = value + (greedy[j] + 1) * desc[j];
+            if (coinGreedyCount(desc, m, w) > count + greedy[j] + 1 && (best == 0 || w < best)) best = w;
+        }
+    }
+    free(greedy);
+    free(desc);
+    return best;
+}
+
+// Random coin system (always with a 1 coin); both tables, checked against
+// the textbook amount-outer loop on small amounts
+void runCoinChangeBenchmark() {
+    int V, n;
+    printf("\n--- Coin Change Engine Benchmark ---\n");
+    printf("Enter amount (e.g. 100000000): ");
+    if (scanf("%d", &V) != 1 || V <= 0) { printf("Invalid input.\n"); return; }
+    printf("Enter number of coin types (e.g. 200): ");
+    if (scanf("%d", &n) != 1 || n <= 0) { printf("Invalid input.\n"); return; }
+
+    int* coins = (int*)malloc(n * sizeof(int));
+    if (coins == NULL) { printf("Memory allocation failed\n"); return; }
+    unsigned int seed = 11;
+    coins[0] = 1;
+    for (int i = 1; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        coins[i] = 2 + (int)((seed >> 8) % 10000);
+    }
+
+    static const int standard[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 2000 };
+    printf(">> Standard coins {1, 2, 5, ..., 2000}: greedy counterexample %lld (0 = canonical)\n",
+           coinGreedyCounterexample(standard, 10));
+    double start = wallSeconds();
+    long long counter = coinGreedyCounterexample(coins, n);
+    printf(">> Random coins: greedy counterexample %lld (%.3f s)\n", counter, wallSeconds() - start);
+
+    start = wallSeconds();
+    int* table = coinMinTable(coins, n, V);
+    double secs = wallSeconds() - start;
+    if (table == NULL) { printf("Memory allocation failed\n"); free(coins); return; }
+    printf(">> Min coins for %d: %d (%.2f s, %.2f G updates/s)\n", V, table[V], secs, (double)V * n / secs / 1e9);
+
+    start = wallSeconds();
+    unsigned int* ways = coinWaysTable(coins, n, V, COIN_MOD);
+    secs = wallSeconds() - start;
+    if (ways) printf(">> Ways for %d (mod %u): %u (%.2f s, %.2f G updates/s)\n", V, COIN_MOD, ways[V], secs, (double)V * n / secs / 1e9);
+
+    // The textbook loop is V * n scalar steps: only compare on small amounts
+    if (V <= 2000000) {
+        int bad = 0;
+        int* check = (int*)malloc(((size_t)V + 1) * sizeof(int));
+        start = wallSeconds();
+        check[0] = 0;
+        for (int i = 1; i <= V; i++) {
+            check[i] = COIN_NONE;
+            for (int j = 0; j < n; j++)
+                if (coins[j] <= i && check[i - coins[j]] + 1 < check[i]) check[i] = check[i - coins[j]] + 1;
+        }
+        printf(">> Textbook loop: %.2f s", wallSeconds() - start);
+        for (int i = 0; i <= V; i++) bad += check[i] != table[i];
+        printf(bad ? " MISMATCH\n" : " ok\n");
+        free(check);
+    }
+    free(coins); free(table); free(ways);
+}
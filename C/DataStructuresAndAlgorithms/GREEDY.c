@@ -55,6 +55,51 @@ int compareEdges(const void* a, const void* b) {
     return a1->weight - b1->weight;
 }
 
+// Comparator for Coin Change (Descending Order of Value)
+int compareCoinsDesc(const void* a, const void* b) {
+    int c1 = *(const int*)a, c2 = *(const int*)b;
+    return (c1 < c2) - (c1 > c2);
+}
+
+// Greedy coin count for x (coins sorted descending)
+long long greedyCoinCount(int coins[], int n, long long x) {
+    long long count = 0;
+    for (int i = 0; i < n && x > 0; i++) {
+        count += x / coins[i];
+        x %= coins[i];
+    }
+    return count;
+}
+
+// Canonical coin system check (Pearson's O(n^3) test). Coins must be
+// distinct, sorted descending and end with 1. The smallest amount where
+// greedy is not optimal, if any, is built from some pair i <= j: take the
+// greedy representation of coins[i-1] - 1, keep its counts of coins[0..j-1],
+// add one to the count of coins[j], drop the rest. Greedy needing more
+// coins than that representation proves the amount is a counterexample.
+// Returns the smallest counterexample, or 0 if greedy is always optimal.
+long long greedyCounterexample(int coins[], int n) {
+    long long best = 0;
+    long long* rep = (long long*)malloc(n * sizeof(long long));
+    if (rep == NULL) return 0;
+
+    for (int i = 1; i < n; i++) {
+        long long x = coins[i - 1] - 1;
+        for (int k = 0; k < n; k++) { rep[k] = x / coins[k]; x %= coins[k]; }
+
+        long long value = 0, count = 0; // Kept part: coins[0..j-1]
+        for (int j = i; j < n; j++) {
+            value += rep[j - 1] * coins[j - 1];
+            count += rep[j - 1];
+            long long w = value + (rep[j] + 1) * coins[j];
+            if (greedyCoinCount(coins, n, w) > count + rep[j] + 1 && (best == 0 || w < best))
+                best = w;
+        }
+    }
+    free(rep);
+    return best;
+}
+
 // Union-Find: Find function
 int find(struct Subset subsets[], int i) {
     if (subsets[i].parent != i)
@@ -224,16 +269,46 @@ void solveKruskal() {
     free(edges); free(subsets); free(result);
 }
 
-// 4. COIN CHANGE PROBLEM (Standard Greedy)
+// 4. COIN CHANGE PROBLEM (Greedy, with Canonical Check)
 void solveCoinChange() {
     printf("\n--- Coin Change Problem (Greedy) ---\n");
     // Standard denominations (e.g., Indian Currency or US)
     // Greedy works for standard canonical coin systems, but not all arbitrary sets.
-    int coins[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 2000 };
-    int n = sizeof(coins) / sizeof(coins[0]);
-    
-    int amount;
+    int standard[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 2000 };
+    int n = sizeof(standard) / sizeof(standard[0]);
+    int* coins = standard;
+
     printf("Available Coins: {1, 2, 5, 10, 20, 50, 100, 200, 500, 2000}\n");
+    printf("Enter number of custom coin types (0 = use standard): ");
+    int custom;
+    if (scanf("%d", &custom) == 1 && custom > 0) {
+        coins = (int*)malloc(custom * sizeof(int));
+        printf("Enter coin values: ");
+        for (int i = 0; i < custom; i++) scanf("%d", &coins[i]);
+        n = custom;
+    }
+
+    // Largest first; drop duplicates and non-positive values
+    qsort(coins, n, sizeof(int), compareCoinsDesc);
+    int distinct = 0;
+    for (int i = 0; i < n; i++)
+        if (coins[i] > 0 && (distinct == 0 || coins[i] != coins[distinct - 1])) coins[distinct++] = coins[i];
+    n = distinct;
+
+    if (n == 0 || coins[n - 1] != 1) {
+        printf("A coin of value 1 is needed for greedy to make every amount.\n");
+        if (coins != standard) free(coins);
+        return;
+    }
+
+    long long counter = greedyCounterexample(coins, n);
+    if (counter == 0)
+        printf("Coin system is canonical: greedy is optimal for every amount.\n");
+    else
+        printf("Warning: coin system is not canonical (greedy is not optimal for %lld);\n"
+               "the result below may not use the fewest coins.\n", counter);
+
+    int amount;
     printf("Enter Amount: ");
     scanf("%d", &amount);
 
@@ -241,7 +316,7 @@ void solveCoinChange() {
     int count = 0;
     
     // Iterate from largest coin to smallest
-    for (int i = n - 1; i >= 0; i--) {
+    for (int i = 0; i < n; i++) {
         while (amount >= coins[i]) {
             amount -= coins[i];
             printf("%d ", coins[i]);
@@ -249,6 +324,8 @@ void solveCoinChange() {
         }
     }
     printf("\nTotal coins used: %d\n", count);
+
+    if (coins != standard) free(coins);
 }
 
 // ================= MAIN DRIVER =================
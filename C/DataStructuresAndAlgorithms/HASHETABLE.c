@@ -2,11 +2,32 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h> // SSE2 group probing for the flat table
+#endif
+#ifdef __AVX2__
+#include <immintrin.h> // 256-bit Bloom block test
+#endif
 
 // --- 1. DATA STRUCTURE DEFINITIONS ---
 
 #define LOAD_FACTOR_THRESHOLD 0.75
 #define INITIAL_CAPACITY 10
+#define SNAPSHOT_FILE "hashtable.pht"
+#define REHASH_STEP_BUCKETS 4   // Old buckets migrated per operation (incremental mode)
+#define LATENCY_BUCKETS 48      // Power-of-two nanosecond buckets: [2^i, 2^(i+1))
+
+// Set to 0 to silence per-operation messages (used by the benchmarks)
+int verbose = 1;
 
 // Node for Separate Chaining (Linked List)
 struct Node {
@@ -15,13 +36,152 @@ struct Node {
     struct Node* next;
 };
 
+// Per-operation latency histogram (log2 buckets of nanoseconds)
+enum { OP_INSERT, OP_SEARCH, OP_DELETE, OP_COUNT };
+
+struct LatencyHistogram {
+    unsigned long long counts[LATENCY_BUCKETS];
+    unsigned long long total;
+    unsigned long long maxNs;
+};
+
+// Optional negative-lookup front (Bloom or cuckoo filter, see section 8c).
+// remove is NULL for filters that cannot delete.
+struct LookupFilter {
+    void* state;
+    void (*add)(void* state, int key);
+    bool (*mayContain)(void* state, int key);
+    bool (*remove)(void* state, int key);
+    void (*destroy)(void* state);
+};
+
 // Hash Table Structure
 struct HashTable {
     struct Node** buckets; // Array of pointers to Nodes
     int capacity;          // Total slots in the array
-    int size;              // Total elements currently stored
+    int size;              // Total elements currently stored (both arrays)
+
+    // Incremental resizing (Redis dict style). While oldBuckets != NULL the
+    // entries are split between two arrays: old buckets [0, rehashIndex)
+    // have already been moved, the rest still live in oldBuckets.
+    bool incremental;
+    struct Node** oldBuckets;
+    int oldCapacity;
+    int rehashIndex;
+
+    struct LatencyHistogram* latency; // OP_COUNT histograms, NULL if not tracking
+    struct LookupFilter* filter;      // Consulted before probing, NULL if none
 };
 
+// --- 1b. HASH FUNCTIONS (Compile-Time Policies) ---
+
+// Every table picks its hash with a macro, so the choice is made when the
+// program is compiled and the call inlines to straight-line code, e.g.
+//     gcc -O2 -DFLAT_HASH=hashWy64 -DCHAINED_HASH=hashMultiplyShift ...
+// All hashes map a key (widened to 64 bits) to 64 bits whose HIGH bits are
+// well mixed; the tables take their bucket index from the top bits
+// (Fibonacci style) or via reduceRange(), never from the low bits.
+// Define CHAINED_USE_MODULO to get the original abs(key) % capacity.
+
+#ifndef CHAINED_HASH
+#define CHAINED_HASH hashFibonacci
+#endif
+#ifndef FLAT_HASH
+#define FLAT_HASH hashMurmur64
+#endif
+#ifndef CONCURRENT_HASH
+#define CONCURRENT_HASH hashMurmur64
+#endif
+#ifndef ROBIN_HOOD_HASH
+#define ROBIN_HOOD_HASH hashMurmur64
+#endif
+
+static inline unsigned long long rotl64(unsigned long long x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// Fibonacci hashing: multiply by 2^64 / golden ratio. One multiply; only the
+// top bits are good, which is exactly what the tables use.
+static inline unsigned long long hashFibonacci(unsigned long long x) {
+    return x * 0x9E3779B97F4A7C15ULL;
+}
+
+// Multiply-shift (Dietzfelbinger): (a * x + b) with a random odd 'a'.
+// Universal over the top bits, still just one multiply and one add.
+static inline unsigned long long hashMultiplyShift(unsigned long long x) {
+    return x * 0xD6E8FEB86659FD93ULL + 0x2D358DCCAA6C78A5ULL;
+}
+
+// MurmurHash3 fmix64: full avalanche, every bit usable
+static inline unsigned long long hashMurmur64(unsigned long long x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// wyhash-style: fold the 128-bit product of two keyed copies of the input
+static inline unsigned long long wyMum(unsigned long long a, unsigned long long b) {
+    unsigned __int128 r = (unsigned __int128)a * b;
+    return (unsigned long long)r ^ (unsigned long long)(r >> 64);
+}
+
+static inline unsigned long long hashWy64(unsigned long long x) {
+    return wyMum(wyMum(x ^ 0xa0761d6478bd642fULL, rotl64(x, 32) ^ 0xe7037ed1a0b428dbULL),
+                 0x8ebc6af09c88c6e3ULL ^ 8);
+}
+
+// xxh3-style: the rrmxmx finalizer XXH3 uses for 4..8 byte inputs
+static inline unsigned long long hashXxh3_64(unsigned long long x) {
+    unsigned long long h = x ^ 0xc73ab174c5ecd5a2ULL;
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= 0x9FB21C651E98DF25ULL;
+    h ^= (h >> 35) + 8;
+    h *= 0x9FB21C651E98DF25ULL;
+    return h ^ (h >> 28);
+}
+
+// String hashes. FNV-1a is tiny and byte-at-a-time; the wyhash-style one
+// consumes 8 bytes per multiply and is much faster on longer keys.
+static inline unsigned long long hashStringFnv1a(const char* s, size_t len) {
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static inline unsigned long long hashStringWy(const char* s, size_t len) {
+    unsigned long long h = 0xa0761d6478bd642fULL ^ len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        unsigned long long w;
+        memcpy(&w, s + i, 8);
+        h = wyMum(h ^ w, 0xe7037ed1a0b428dbULL);
+    }
+    if (i < len) {
+        unsigned long long w = 0;
+        for (size_t j = 0; i + j < len; j++) w |= (unsigned long long)(unsigned char)s[i + j] << (8 * j);
+        h = wyMum(h ^ w, 0x8ebc6af09c88c6e3ULL);
+    }
+    return wyMum(h, 0x589965cc75374cc3ULL);
+}
+
+// Index reducers.
+// Power-of-two table: keep the top log2(capacity) bits (Fibonacci hashing)
+static inline int hashIndex(unsigned long long h, int capacity) {
+    return (int)(h >> (64 - __builtin_ctz(capacity)));
+}
+
+// Any capacity: ((h >> 32) * capacity) >> 32 maps the top 32 bits onto
+// [0, capacity) with a multiply instead of a division
+static inline int reduceRange(unsigned long long h, int capacity) {
+    return (int)(((h >> 32) * (unsigned long long)capacity) >> 32);
+}
+
 // --- 2. CORE UTILITIES ---
 
 // Create a new Node
@@ -41,190 +201,2436 @@ struct HashTable* createTable(int capacity) {
     
     // Allocate memory for buckets and initialize to NULL
     ht->buckets = (struct Node**)calloc(capacity, sizeof(struct Node*));
+
+    ht->incremental = false;
+    ht->oldBuckets = NULL;
+    ht->oldCapacity = 0;
+    ht->rehashIndex = 0;
+    ht->latency = NULL;
+    ht->filter = NULL;
+    return ht;
+}
+
+// Same table, but resizes spread their work over later operations
+struct HashTable* createIncrementalTable(int capacity) {
+    struct HashTable* ht = createTable(capacity);
+    ht->incremental = true;
     return ht;
 }
 
 // HASH FUNCTION: Maps a key to an index
-// We use simple Modulo arithmetic here.
+// Modulo is the textbook version, but it clusters on strided ids and pays
+// for a division on every call, so by default we hash and reduce instead.
 int hashFunction(int key, int capacity) {
+#ifdef CHAINED_USE_MODULO
     return abs(key) % capacity;
+#else
+    return reduceRange(CHAINED_HASH((unsigned int)key), capacity);
+#endif
 }
 
 // --- 3. DYNAMIC RESIZING (REHASHING) ---
 
-// Forward declaration needed for internal use
-void insert(struct HashTable* ht, int key, int value);
+// Relinks every node of a chain into ht->buckets (no allocation)
+static void moveChain(struct HashTable* ht, struct Node* current) {
+    while (current != NULL) {
+        struct Node* next = current->next;
+        int index = hashFunction(current->key, ht->capacity);
+        current->next = ht->buckets[index];
+        ht->buckets[index] = current;
+        current = next;
+    }
+}
+
+// Migrates up to 'steps' non-empty old buckets. Like Redis, it also caps the
+// number of empty buckets visited so one call stays cheap.
+void rehashStep(struct HashTable* ht, int steps) {
+    int emptyVisits = steps * 10;
+
+    while (ht->oldBuckets != NULL && steps > 0) {
+        if (ht->rehashIndex == ht->oldCapacity) {
+            free(ht->oldBuckets);
+            ht->oldBuckets = NULL;
+            ht->oldCapacity = 0;
+            ht->rehashIndex = 0;
+            if (verbose) printf("[Success] Incremental resize complete.\n");
+            return;
+        }
+        struct Node* chain = ht->oldBuckets[ht->rehashIndex];
+        ht->oldBuckets[ht->rehashIndex++] = NULL;
+        if (chain == NULL) {
+            if (--emptyVisits == 0) return;
+            continue;
+        }
+        moveChain(ht, chain);
+        steps--;
+    }
+}
 
 // Resizes the table when Load Factor > 0.75
 void rehash(struct HashTable* ht) {
     int oldCapacity = ht->capacity;
     struct Node** oldBuckets = ht->buckets;
 
-    printf("\n[Notice] Load Factor High. Resizing table from %d to %d...\n", 
-           oldCapacity, oldCapacity * 2);
+    if (verbose) printf("\n[Notice] Load Factor High. Resizing table from %d to %d%s...\n", 
+                        oldCapacity, oldCapacity * 2, ht->incremental ? " (incrementally)" : "");
 
     // 1. Update Table Properties
     ht->capacity *= 2;
-    ht->size = 0; // Reset size, insert() will increment it back
     ht->buckets = (struct Node**)calloc(ht->capacity, sizeof(struct Node*));
 
-    // 2. Move existing nodes to new buckets
+    // 2a. Incremental: keep the old array, later operations move it over
+    if (ht->incremental) {
+        ht->oldBuckets = oldBuckets;
+        ht->oldCapacity = oldCapacity;
+        ht->rehashIndex = 0;
+        return;
+    }
+
+    // 2b. Blocking: move existing nodes to new buckets right now
     for (int i = 0; i < oldCapacity; i++) {
-        struct Node* current = oldBuckets[i];
-        while (current != NULL) {
-            struct Node* temp = current;
-            insert(ht, current->key, current->value); // Re-insert into new array
-            current = current->next;
-            free(temp); // Free the old node wrapper (insert creates a new one)
-        }
+        moveChain(ht, oldBuckets[i]);
     }
     free(oldBuckets); // Free the old array pointer
-    printf("[Success] Table Resized.\n");
+    if (verbose) printf("[Success] Table Resized.\n");
 }
 
-// --- 4. CORE OPERATIONS ---
+// Finishes any in-progress incremental resize
+void finishRehash(struct HashTable* ht) {
+    while (ht->oldBuckets != NULL) rehashStep(ht, ht->oldCapacity);
+}
 
-// INSERT (or Update if key exists)
-void insert(struct HashTable* ht, int key, int value) {
-    // 1. Check Load Factor
-    float loadFactor = (float)ht->size / ht->capacity;
-    if (loadFactor > LOAD_FACTOR_THRESHOLD) {
-        rehash(ht);
-    }
+// --- 3b. LATENCY TRACKING ---
+
+static unsigned long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
 
-    int index = hashFunction(key, ht->capacity);
-    struct Node* current = ht->buckets[index];
+void enableLatencyTracking(struct HashTable* ht) {
+    if (ht->latency == NULL)
+        ht->latency = (struct LatencyHistogram*)calloc(OP_COUNT, sizeof(struct LatencyHistogram));
+}
 
-    // 2. Update if Key already exists
-    while (current != NULL) {
-        if (current->key == key) {
-            current->value = value; // Update value
-            printf(">> Updated Key %d with new Value %d.\n", key, value);
-            return;
-        }
-        current = current->next;
+static void histogramAdd(struct LatencyHistogram* h, unsigned long long ns) {
+    int bucket = (ns == 0) ? 0 : 63 - __builtin_clzll(ns);
+    if (bucket >= LATENCY_BUCKETS) bucket = LATENCY_BUCKETS - 1;
+    h->counts[bucket]++;
+    h->total++;
+    if (ns > h->maxNs) h->maxNs = ns;
+}
+
+static void recordLatency(struct HashTable* ht, int op, unsigned long long start) {
+    histogramAdd(&ht->latency[op], nowNs() - start);
+}
+
+// Upper bound (ns) of the bucket holding the q-th quantile, e.g. q = 0.999
+unsigned long long latencyPercentile(const struct LatencyHistogram* h, double q) {
+    unsigned long long target = (unsigned long long)(q * h->total);
+    unsigned long long seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen > target) return 1ULL << (i + 1);
     }
+    return h->maxNs;
+}
+
+void printLatencyReport(struct HashTable* ht) {
+    static const char* names[OP_COUNT] = { "insert", "search", "delete" };
+    if (ht->latency == NULL) { printf("Latency tracking is off.\n"); return; }
 
-    // 3. Insert new Key (at head of chain)
-    struct Node* newNode = createNode(key, value);
-    newNode->next = ht->buckets[index];
-    ht->buckets[index] = newNode;
-    ht->size++;
-    printf(">> Inserted { %d : %d } at Index %d.\n", key, value, index);
+    printf("%-8s %10s %10s %10s %10s %12s\n", "op", "count", "p50(ns)", "p99(ns)", "p999(ns)", "max(ns)");
+    for (int op = 0; op < OP_COUNT; op++) {
+        const struct LatencyHistogram* h = &ht->latency[op];
+        if (h->total == 0) continue;
+        printf("%-8s %10llu %10llu %10llu %10llu %12llu\n", names[op], h->total,
+               latencyPercentile(h, 0.50), latencyPercentile(h, 0.99),
+               latencyPercentile(h, 0.999), h->maxNs);
+    }
 }
 
-// SEARCH: Returns value or -1 if not found
-int search(struct HashTable* ht, int key) {
-    int index = hashFunction(key, ht->capacity);
-    struct Node* current = ht->buckets[index];
+// --- 4. CORE OPERATIONS ---
 
+// Finds the node for 'key' in whichever array currently holds it
+static struct Node* findNode(struct HashTable* ht, int key) {
+    struct Node* current = ht->buckets[hashFunction(key, ht->capacity)];
     while (current != NULL) {
-        if (current->key == key) {
-            return current->value;
-        }
+        if (current->key == key) return current;
         current = current->next;
     }
-    return -1; // Not found indicator
+
+    if (ht->oldBuckets != NULL) {
+        int oldIndex = hashFunction(key, ht->oldCapacity);
+        if (oldIndex >= ht->rehashIndex) {
+            current = ht->oldBuckets[oldIndex];
+            while (current != NULL) {
+                if (current->key == key) return current;
+                current = current->next;
+            }
+        }
+    }
+    return NULL;
 }
 
-// DELETE: Removes a key-value pair
-void deleteKey(struct HashTable* ht, int key) {
-    int index = hashFunction(key, ht->capacity);
-    struct Node* current = ht->buckets[index];
+// Unlinks and frees 'key' from one chain. Returns true if it was there.
+static bool removeFromChain(struct Node** head, int key) {
+    struct Node* current = *head;
     struct Node* prev = NULL;
 
     while (current != NULL) {
         if (current->key == key) {
             // Case: Head of list
             if (prev == NULL) {
-                ht->buckets[index] = current->next;
+                *head = current->next;
             } else {
                 prev->next = current->next;
             }
             free(current);
-            ht->size--;
-            printf(">> Key %d deleted successfully.\n", key);
-            return;
+            return true;
         }
         prev = current;
         current = current->next;
     }
-    printf(">> Key %d not found.\n", key);
+    return false;
+}
+
+// INSERT (or Update if key exists)
+void insert(struct HashTable* ht, int key, int value) {
+    unsigned long long start = ht->latency ? nowNs() : 0;
+    if (ht->oldBuckets != NULL) rehashStep(ht, REHASH_STEP_BUCKETS);
+
+    // 1. Check Load Factor (never start a resize while one is running)
+    float loadFactor = (float)ht->size / ht->capacity;
+    if (loadFactor > LOAD_FACTOR_THRESHOLD && ht->oldBuckets == NULL) {
+        rehash(ht);
+    }
+
+    // 2. Update if Key already exists
+    struct Node* existing = findNode(ht, key);
+    if (existing != NULL) {
+        existing->value = value; // Update value
+        if (verbose) printf(">> Updated Key %d with new Value %d.\n", key, value);
+    } else {
+        // 3. Insert new Key (at head of chain, always in the newest array)
+        int index = hashFunction(key, ht->capacity);
+        struct Node* newNode = createNode(key, value);
+        newNode->next = ht->buckets[index];
+        ht->buckets[index] = newNode;
+        ht->size++;
+        if (ht->filter) ht->filter->add(ht->filter->state, key);
+        if (verbose) printf(">> Inserted { %d : %d } at Index %d.\n", key, value, index);
+    }
+    if (ht->latency) recordLatency(ht, OP_INSERT, start);
+}
+
+// SEARCH: Returns value or -1 if not found
+int search(struct HashTable* ht, int key) {
+    unsigned long long start = ht->latency ? nowNs() : 0;
+    if (ht->oldBuckets != NULL) rehashStep(ht, REHASH_STEP_BUCKETS);
+
+    int result = -1; // -1 is the Not found indicator
+    if (ht->filter == NULL || ht->filter->mayContain(ht->filter->state, key)) {
+        struct Node* node = findNode(ht, key);
+        if (node != NULL) result = node->value;
+    }
+    if (ht->latency) recordLatency(ht, OP_SEARCH, start);
+    return result;
+}
+
+// DELETE: Removes a key-value pair
+void deleteKey(struct HashTable* ht, int key) {
+    unsigned long long start = ht->latency ? nowNs() : 0;
+    if (ht->oldBuckets != NULL) rehashStep(ht, REHASH_STEP_BUCKETS);
+
+    bool removed = removeFromChain(&ht->buckets[hashFunction(key, ht->capacity)], key);
+    if (!removed && ht->oldBuckets != NULL) {
+        int oldIndex = hashFunction(key, ht->oldCapacity);
+        if (oldIndex >= ht->rehashIndex)
+            removed = removeFromChain(&ht->oldBuckets[oldIndex], key);
+    }
+
+    if (removed) {
+        ht->size--;
+        if (ht->filter && ht->filter->remove) ht->filter->remove(ht->filter->state, key);
+        if (verbose) printf(">> Key %d deleted successfully.\n", key);
+    } else {
+        if (verbose) printf(">> Key %d not found.\n", key);
+    }
+    if (ht->latency) recordLatency(ht, OP_DELETE, start);
 }
 
 // --- 5. VISUALIZATION ---
 
-void display(struct HashTable* ht) {
-    printf("\n--- Hash Table Snapshot ---\n");
-    printf("Capacity: %d | Size: %d | Load Factor: %.2f\n", 
-           ht->capacity, ht->size, (float)ht->size/ht->capacity);
-    
-    for (int i = 0; i < ht->capacity; i++) {
-        if (ht->buckets[i] == NULL) continue; // Skip empty buckets for cleaner view
+static void displayBuckets(struct Node** buckets, int from, int capacity) {
+    for (int i = from; i < capacity; i++) {
+        if (buckets[i] == NULL) continue; // Skip empty buckets for cleaner view
 
         printf("Index %d: ", i);
-        struct Node* current = ht->buckets[i];
+        struct Node* current = buckets[i];
         while (current != NULL) {
             printf("[K:%d V:%d] -> ", current->key, current->value);
             current = current->next;
         }
         printf("NULL\n");
     }
+}
+
+void display(struct HashTable* ht) {
+    printf("\n--- Hash Table Snapshot ---\n");
+    printf("Capacity: %d | Size: %d | Load Factor: %.2f\n", 
+           ht->capacity, ht->size, (float)ht->size/ht->capacity);
+    
+    displayBuckets(ht->buckets, 0, ht->capacity);
+    if (ht->oldBuckets != NULL) {
+        printf("(Resize in progress: old array, %d of %d buckets migrated)\n",
+               ht->rehashIndex, ht->oldCapacity);
+        displayBuckets(ht->oldBuckets, ht->rehashIndex, ht->oldCapacity);
+    }
     printf("---------------------------\n");
 }
 
-void cleanUp(struct HashTable* ht) {
-    for (int i = 0; i < ht->capacity; i++) {
-        struct Node* current = ht->buckets[i];
+static void freeBuckets(struct Node** buckets, int capacity) {
+    for (int i = 0; i < capacity; i++) {
+        struct Node* current = buckets[i];
         while (current != NULL) {
             struct Node* temp = current;
             current = current->next;
             free(temp);
         }
     }
-    free(ht->buckets);
+    free(buckets);
+}
+
+void cleanUp(struct HashTable* ht) {
+    freeBuckets(ht->buckets, ht->capacity);
+    if (ht->oldBuckets != NULL) freeBuckets(ht->oldBuckets, ht->oldCapacity);
+    free(ht->latency);
+    if (ht->filter != NULL) {
+        ht->filter->destroy(ht->filter->state);
+        free(ht->filter);
+    }
     free(ht);
 }
 
-// --- 6. MAIN DRIVER ---
+// --- 6. FLAT TABLE (SwissTable-style Open Addressing) ---
 
-int main() {
-    struct HashTable* ht = createTable(INITIAL_CAPACITY);
-    int choice, key, val, result;
+// All entries live in one flat slot array; a parallel array of 1-byte
+// control tags says what each slot holds. A lookup loads 16 tags at once,
+// compares them against the 7-bit fingerprint of the key with SSE2 and
+// only touches slots whose tag matches, so there is no pointer chasing.
+//
+// Control byte values:
+//   EMPTY    (0x80) - never used, ends a probe sequence
+//   DELETED  (0xFE) - tombstone, probes continue past it
+//   0..127          - FULL, top 7 bits of the key's hash (H2)
+// The group position (H1) comes from the hash bits just below H2, so tag
+// and position are independent and both use the well-mixed high bits.
 
-    printf("=== MASTER HASH TABLE (Separate Chaining) ===\n");
+#define CTRL_EMPTY   ((signed char)-128)
+#define CTRL_DELETED ((signed char)-2)
+#define GROUP_WIDTH 16
+#define FLAT_MIN_CAPACITY 16
+
+struct Slot {
+    int key;
+    int value;
+};
+
+struct FlatHashTable {
+    signed char* ctrl;   // capacity + GROUP_WIDTH - 1 tags (tail mirrors the head)
+    struct Slot* slots;  // capacity entries
+    int capacity;        // Always a power of two
+    int size;            // FULL slots
+    int tombstones;      // DELETED slots
+};
+
+// Bitmask of the 16 tags starting at 'ctrl' that equal 'tag'
+static inline unsigned int groupMatch(const signed char* ctrl, signed char tag) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag)));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++)
+        if (ctrl[i] == tag) mask |= 1u << i;
+    return mask;
+#endif
+}
+
+// Bitmask of EMPTY or DELETED tags (both have the sign bit set)
+static inline unsigned int groupMatchFree(const signed char* ctrl) {
+#ifdef __SSE2__
+    return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++)
+        if (ctrl[i] < 0) mask |= 1u << i;
+    return mask;
+#endif
+}
+
+static inline int lowestBit(unsigned int mask) { return __builtin_ctz(mask); }
+
+// Writes a tag, keeping the mirrored tail in sync so that a 16-byte load
+// starting near the end of the array sees the wrapped-around tags.
+static void setCtrl(struct FlatHashTable* ft, int i, signed char tag) {
+    ft->ctrl[i] = tag;
+    if (i < GROUP_WIDTH - 1) ft->ctrl[ft->capacity + i] = tag;
+}
+
+struct FlatHashTable* createFlatTable(int capacity) {
+    int cap = FLAT_MIN_CAPACITY;
+    while (cap < capacity) cap *= 2;
+
+    struct FlatHashTable* ft = (struct FlatHashTable*)malloc(sizeof(struct FlatHashTable));
+    ft->capacity = cap;
+    ft->size = 0;
+    ft->tombstones = 0;
+    ft->ctrl = (signed char*)malloc(cap + GROUP_WIDTH - 1);
+    memset(ft->ctrl, CTRL_EMPTY, cap + GROUP_WIDTH - 1);
+    ft->slots = (struct Slot*)malloc(sizeof(struct Slot) * cap);
+    return ft;
+}
+
+static inline int flatH1(unsigned long long h, int capacity) {
+    return hashIndex(h << 7, capacity);
+}
+
+static inline signed char flatH2(unsigned long long h) {
+    return (signed char)(h >> 57);
+}
+
+// Returns the slot index holding 'key', or -1.
+// Probing visits 16-wide groups with a triangular stride, which reaches
+// every group of a power-of-two table. Any EMPTY tag ends the search.
+static int flatFind(struct FlatHashTable* ft, int key) {
+    unsigned long long h = FLAT_HASH((unsigned int)key);
+    signed char h2 = flatH2(h);
+    int mask = ft->capacity - 1;
+    int pos = flatH1(h, ft->capacity);
+    int stride = 0;
 
     while (1) {
-        printf("\n1. Insert (Key, Value)\n2. Search (Key)\n");
-        printf("3. Delete (Key)\n4. Display Table\n5. Exit\n");
-        printf("Enter Choice: ");
-        
-        if (scanf("%d", &choice) != 1) break;
+        unsigned int match = groupMatch(ft->ctrl + pos, h2);
+        while (match) {
+            int i = (pos + lowestBit(match)) & mask;
+            if (ft->slots[i].key == key) return i;
+            match &= match - 1;
+        }
+        if (groupMatch(ft->ctrl + pos, CTRL_EMPTY)) return -1;
+        stride += GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+}
 
-        switch (choice) {
-            case 1:
-                printf("Enter Key (int): ");
-                scanf("%d", &key);
-                printf("Enter Value (int): ");
-                scanf("%d", &val);
-                insert(ht, key, val);
-                break;
-            case 2:
-                printf("Enter Key to Search: ");
-                scanf("%d", &key);
-                result = search(ht, key);
-                if (result != -1) printf("Found! Value: %d\n", result);
-                else printf("Key not found.\n");
-                break;
-            case 3:
-                printf("Enter Key to Delete: ");
-                scanf("%d", &key);
-                deleteKey(ht, key);
-                break;
-            case 4:
-                display(ht);
-                break;
-            case 5:
+// First EMPTY or DELETED slot on the key's probe sequence
+static int flatFindFree(struct FlatHashTable* ft, unsigned long long h) {
+    int mask = ft->capacity - 1;
+    int pos = flatH1(h, ft->capacity);
+    int stride = 0;
+
+    while (1) {
+        unsigned int free = groupMatchFree(ft->ctrl + pos);
+        if (free) return (pos + lowestBit(free)) & mask;
+        stride += GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+}
+
+void flatInsert(struct FlatHashTable* ft, int key, int value);
+
+// Rebuilds into 'newCapacity' slots; this also drops every tombstone
+static void flatResize(struct FlatHashTable* ft, int newCapacity) {
+    signed char* oldCtrl = ft->ctrl;
+    struct Slot* oldSlots = ft->slots;
+    int oldCapacity = ft->capacity;
+
+    ft->capacity = newCapacity;
+    ft->size = 0;
+    ft->tombstones = 0;
+    ft->ctrl = (signed char*)malloc(newCapacity + GROUP_WIDTH - 1);
+    memset(ft->ctrl, CTRL_EMPTY, newCapacity + GROUP_WIDTH - 1);
+    ft->slots = (struct Slot*)malloc(sizeof(struct Slot) * newCapacity);
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] >= 0) {
+            unsigned long long h = FLAT_HASH((unsigned int)oldSlots[i].key);
+            int slot = flatFindFree(ft, h);
+            setCtrl(ft, slot, flatH2(h));
+            ft->slots[slot] = oldSlots[i];
+            ft->size++;
+        }
+    }
+    free(oldCtrl);
+    free(oldSlots);
+}
+
+// INSERT (or Update if key exists). Max load factor is 7/8, counting
+// tombstones, because they lengthen probes just like live entries.
+void flatInsert(struct FlatHashTable* ft, int key, int value) {
+    int i = flatFind(ft, key);
+    if (i >= 0) {
+        ft->slots[i].value = value;
+        return;
+    }
+
+    if ((ft->size + ft->tombstones + 1) * 8 > ft->capacity * 7) {
+        // Mostly tombstones: rehash in place. Otherwise: grow.
+        if (ft->size * 16 < ft->capacity * 7) flatResize(ft, ft->capacity);
+        else flatResize(ft, ft->capacity * 2);
+    }
+
+    unsigned long long h = FLAT_HASH((unsigned int)key);
+    int slot = flatFindFree(ft, h);
+    if (ft->ctrl[slot] == CTRL_DELETED) ft->tombstones--;
+    setCtrl(ft, slot, flatH2(h));
+    ft->slots[slot].key = key;
+    ft->slots[slot].value = value;
+    ft->size++;
+}
+
+// SEARCH: Returns value or -1 if not found (same contract as search())
+int flatSearch(struct FlatHashTable* ft, int key) {
+    int i = flatFind(ft, key);
+    return (i >= 0) ? ft->slots[i].value : -1;
+}
+
+// DELETE: A slot can go straight back to EMPTY only if no probe could ever
+// have passed over it, i.e. no run of 16 non-empty tags covers it.
+// Otherwise it becomes a tombstone so later lookups keep probing.
+void flatDeleteKey(struct FlatHashTable* ft, int key) {
+    int i = flatFind(ft, key);
+    if (i < 0) return;
+
+    int mask = ft->capacity - 1;
+    int before = (i - GROUP_WIDTH) & mask;
+    unsigned int emptyAfter = groupMatch(ft->ctrl + i, CTRL_EMPTY);
+    unsigned int emptyBefore = groupMatch(ft->ctrl + before, CTRL_EMPTY);
+
+    // Non-empty run after i (from its low bits) and before i (from its high bits)
+    int runAfter = emptyAfter ? __builtin_ctz(emptyAfter) : GROUP_WIDTH;
+    int runBefore = emptyBefore ? __builtin_clz(emptyBefore) - (32 - GROUP_WIDTH) : GROUP_WIDTH;
+
+    if (emptyAfter && emptyBefore && runAfter + runBefore < GROUP_WIDTH) {
+        setCtrl(ft, i, CTRL_EMPTY);
+    } else {
+        setCtrl(ft, i, CTRL_DELETED);
+        ft->tombstones++;
+    }
+    ft->size--;
+}
+
+void cleanUpFlat(struct FlatHashTable* ft) {
+    free(ft->ctrl);
+    free(ft->slots);
+    free(ft);
+}
+
+// --- 7. CONCURRENT TABLE (Striped Locks + Lock-Free Reads) ---
+
+// Shared by many threads (needs -pthread on older toolchains).
+//   Reads  : lock-free. Chains are only ever changed by publishing a fully
+//            built node with one atomic store, so a reader never sees a
+//            half-written entry.
+//   Writes : one mutex per stripe. The stripe is the top LOCK_STRIPE_BITS
+//            bits of the hash, which are also the top bits of the bucket
+//            index, so a bucket keeps the same stripe at every table size.
+//   Resize : takes all stripe locks (writers wait), copies the entries into
+//            a new bucket array and publishes it with one atomic store.
+//            Readers keep going on whichever array they loaded.
+//   Memory : removed nodes and replaced arrays are retired to epoch-based
+//            reclamation and freed only once no reader can still see them.
+
+#define LOCK_STRIPE_BITS 6
+#define LOCK_STRIPES (1 << LOCK_STRIPE_BITS)
+#define MAX_THREADS 64
+#define EBR_RETIRE_BATCH 64
+
+struct CNode {
+    int key;
+    _Atomic int value;
+    _Atomic(struct CNode*) next;
+};
+
+struct CBucketArray {
+    int capacity; // Power of two, >= LOCK_STRIPES
+    _Atomic(struct CNode*) buckets[];
+};
+
+// Something waiting for a grace period before it can be freed
+struct Retired {
+    void* ptr;
+    void (*freeFn)(void*);
+    struct Retired* next;
+};
+
+// Per-thread epoch record, aligned to its own cache line (the table is
+// allocated with aligned_alloc so the alignment holds)
+struct ThreadRecord {
+    _Alignas(64) _Atomic unsigned long epoch;
+    _Atomic int active;
+    unsigned long lastEpoch;
+    int retiredSinceAdvance;
+    struct Retired* limbo[3]; // Indexed by epoch % 3
+};
+
+struct ConcurrentHashTable {
+    _Atomic(struct CBucketArray*) table;
+    _Atomic int size;
+    pthread_mutex_t stripes[LOCK_STRIPES];
+    pthread_mutex_t resizeLock;
+
+    _Atomic unsigned long globalEpoch;
+    _Atomic int threadCount;
+    struct ThreadRecord threads[MAX_THREADS];
+};
+
+// --- 7a. Epoch-based reclamation ---
+// A thread announces the global epoch while it reads. The global epoch only
+// advances once every active thread has announced it, so anything retired
+// in epoch e is unreachable by the time the epoch reaches e + 2.
+
+static void freeRetiredList(struct Retired* r) {
+    while (r != NULL) {
+        struct Retired* next = r->next;
+        r->freeFn(r->ptr);
+        free(r);
+        r = next;
+    }
+}
+
+static void epochEnter(struct ConcurrentHashTable* ct, int tid) {
+    struct ThreadRecord* rec = &ct->threads[tid];
+    atomic_store(&rec->active, 1);
+    unsigned long e = atomic_load(&ct->globalEpoch);
+    atomic_store(&rec->epoch, e);
+
+    // limbo[e % 3] holds items retired in epoch e - 3 or earlier: now safe
+    if (rec->lastEpoch != e) {
+        freeRetiredList(rec->limbo[e % 3]);
+        rec->limbo[e % 3] = NULL;
+        rec->lastEpoch = e;
+    }
+}
+
+static void epochExit(struct ConcurrentHashTable* ct, int tid) {
+    atomic_store_explicit(&ct->threads[tid].active, 0, memory_order_release);
+}
+
+static void epochTryAdvance(struct ConcurrentHashTable* ct) {
+    unsigned long e = atomic_load(&ct->globalEpoch);
+    int n = atomic_load(&ct->threadCount);
+    for (int i = 0; i < n; i++) {
+        if (atomic_load(&ct->threads[i].active) && atomic_load(&ct->threads[i].epoch) != e) return;
+    }
+    atomic_compare_exchange_strong(&ct->globalEpoch, &e, e + 1);
+}
+
+// Must be called between epochEnter and epochExit
+static void epochRetire(struct ConcurrentHashTable* ct, int tid, void* ptr, void (*freeFn)(void*)) {
+    struct ThreadRecord* rec = &ct->threads[tid];
+    struct Retired* r = (struct Retired*)malloc(sizeof(struct Retired));
+    unsigned long e = atomic_load_explicit(&rec->epoch, memory_order_relaxed);
+    r->ptr = ptr;
+    r->freeFn = freeFn;
+    r->next = rec->limbo[e % 3];
+    rec->limbo[e % 3] = r;
+    if (++rec->retiredSinceAdvance >= EBR_RETIRE_BATCH) {
+        rec->retiredSinceAdvance = 0;
+        epochTryAdvance(ct);
+    }
+}
+
+// --- 7b. Table operations ---
+
+static struct CBucketArray* createBucketArray(int capacity) {
+    struct CBucketArray* arr = (struct CBucketArray*)calloc(1, sizeof(struct CBucketArray) +
+                                                           sizeof(_Atomic(struct CNode*)) * capacity);
+    arr->capacity = capacity;
+    return arr;
+}
+
+// Frees a replaced array together with the node copies it still owns
+static void freeBucketArray(void* p) {
+    struct CBucketArray* arr = (struct CBucketArray*)p;
+    for (int i = 0; i < arr->capacity; i++) {
+        struct CNode* n = atomic_load_explicit(&arr->buckets[i], memory_order_relaxed);
+        while (n != NULL) {
+            struct CNode* next = atomic_load_explicit(&n->next, memory_order_relaxed);
+            free(n);
+            n = next;
+        }
+    }
+    free(arr);
+}
+
+struct ConcurrentHashTable* createConcurrentTable(int capacity) {
+    int cap = LOCK_STRIPES;
+    while (cap < capacity) cap *= 2;
+
+    struct ConcurrentHashTable* ct = (struct ConcurrentHashTable*)aligned_alloc(_Alignof(struct ConcurrentHashTable),
+                                                                                sizeof(struct ConcurrentHashTable));
+    memset(ct, 0, sizeof(struct ConcurrentHashTable));
+    atomic_init(&ct->table, createBucketArray(cap));
+    for (int i = 0; i < LOCK_STRIPES; i++) pthread_mutex_init(&ct->stripes[i], NULL);
+    pthread_mutex_init(&ct->resizeLock, NULL);
+    return ct;
+}
+
+// Each thread calls this once and passes the returned id to every operation.
+// Returns -1 when MAX_THREADS threads are already registered.
+int concurrentRegisterThread(struct ConcurrentHashTable* ct) {
+    int tid = atomic_fetch_add(&ct->threadCount, 1);
+    if (tid >= MAX_THREADS) {
+        atomic_fetch_sub(&ct->threadCount, 1);
+        return -1;
+    }
+    return tid;
+}
+
+// Lock-free lookup. Returns value or -1 if not found.
+int concurrentSearch(struct ConcurrentHashTable* ct, int tid, int key) {
+    int result = -1;
+    epochEnter(ct, tid);
+
+    struct CBucketArray* arr = atomic_load_explicit(&ct->table, memory_order_acquire);
+    unsigned long long h = CONCURRENT_HASH((unsigned int)key);
+    struct CNode* n = atomic_load_explicit(&arr->buckets[hashIndex(h, arr->capacity)], memory_order_acquire);
+    while (n != NULL) {
+        if (n->key == key) {
+            result = atomic_load_explicit(&n->value, memory_order_acquire);
+            break;
+        }
+        n = atomic_load_explicit(&n->next, memory_order_acquire);
+    }
+
+    epochExit(ct, tid);
+    return result;
+}
+
+// Doubles the bucket array. Readers are never blocked: they finish on the
+// old array, which is retired rather than freed.
+static void concurrentResize(struct ConcurrentHashTable* ct, int tid) {
+    if (pthread_mutex_trylock(&ct->resizeLock) != 0) return; // Someone else is on it
+    for (int i = 0; i < LOCK_STRIPES; i++) pthread_mutex_lock(&ct->stripes[i]);
+
+    struct CBucketArray* old = atomic_load_explicit(&ct->table, memory_order_relaxed);
+    if (atomic_load(&ct->size) > old->capacity * LOAD_FACTOR_THRESHOLD) {
+        struct CBucketArray* arr = createBucketArray(old->capacity * 2);
+        for (int i = 0; i < old->capacity; i++) {
+            struct CNode* n = atomic_load_explicit(&old->buckets[i], memory_order_relaxed);
+            while (n != NULL) {
+                // Copy: readers may still be walking the old chains
+                struct CNode* copy = (struct CNode*)malloc(sizeof(struct CNode));
+                int index = hashIndex(CONCURRENT_HASH((unsigned int)n->key), arr->capacity);
+                copy->key = n->key;
+                atomic_init(&copy->value, atomic_load_explicit(&n->value, memory_order_relaxed));
+                atomic_init(&copy->next, atomic_load_explicit(&arr->buckets[index], memory_order_relaxed));
+                atomic_store_explicit(&arr->buckets[index], copy, memory_order_relaxed);
+                n = atomic_load_explicit(&n->next, memory_order_relaxed);
+            }
+        }
+        atomic_store_explicit(&ct->table, arr, memory_order_release);
+
+        epochEnter(ct, tid);
+        epochRetire(ct, tid, old, freeBucketArray);
+        epochExit(ct, tid);
+    }
+
+    for (int i = LOCK_STRIPES - 1; i >= 0; i--) pthread_mutex_unlock(&ct->stripes[i]);
+    pthread_mutex_unlock(&ct->resizeLock);
+}
+
+// INSERT (or Update if key exists)
+void concurrentInsert(struct ConcurrentHashTable* ct, int tid, int key, int value) {
+    unsigned long long h = CONCURRENT_HASH((unsigned int)key);
+    pthread_mutex_t* lock = &ct->stripes[h >> (64 - LOCK_STRIPE_BITS)];
+    bool added = false;
+
+    pthread_mutex_lock(lock);
+    // Load the array only after locking: a resize holds every stripe
+    struct CBucketArray* arr = atomic_load_explicit(&ct->table, memory_order_acquire);
+    int capacity = arr->capacity; // arr may be retired and freed once we unlock
+    _Atomic(struct CNode*)* head = &arr->buckets[hashIndex(h, capacity)];
+
+    struct CNode* n = atomic_load_explicit(head, memory_order_relaxed);
+    while (n != NULL && n->key != key) n = atomic_load_explicit(&n->next, memory_order_relaxed);
+
+    if (n != NULL) {
+        atomic_store_explicit(&n->value, value, memory_order_release);
+    } else {
+        struct CNode* node = (struct CNode*)malloc(sizeof(struct CNode));
+        node->key = key;
+        atomic_init(&node->value, value);
+        atomic_init(&node->next, atomic_load_explicit(head, memory_order_relaxed));
+        atomic_store_explicit(head, node, memory_order_release); // Publish
+        added = true;
+    }
+    pthread_mutex_unlock(lock);
+
+    if (added && atomic_fetch_add(&ct->size, 1) + 1 > capacity * LOAD_FACTOR_THRESHOLD)
+        concurrentResize(ct, tid);
+}
+
+// DELETE: Unlinks the node; readers already on it can still follow its next
+// pointer, and it is freed after a grace period.
+void concurrentDeleteKey(struct ConcurrentHashTable* ct, int tid, int key) {
+    unsigned long long h = CONCURRENT_HASH((unsigned int)key);
+    pthread_mutex_t* lock = &ct->stripes[h >> (64 - LOCK_STRIPE_BITS)];
+
+    epochEnter(ct, tid);
+    pthread_mutex_lock(lock);
+    struct CBucketArray* arr = atomic_load_explicit(&ct->table, memory_order_acquire);
+    _Atomic(struct CNode*)* link = &arr->buckets[hashIndex(h, arr->capacity)];
+
+    struct CNode* n = atomic_load_explicit(link, memory_order_relaxed);
+    while (n != NULL && n->key != key) {
+        link = &n->next;
+        n = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    if (n != NULL) {
+        atomic_store_explicit(link, atomic_load_explicit(&n->next, memory_order_relaxed), memory_order_release);
+        atomic_fetch_sub(&ct->size, 1);
+    }
+    pthread_mutex_unlock(lock);
+
+    if (n != NULL) epochRetire(ct, tid, n, free);
+    epochExit(ct, tid);
+}
+
+// Call only after all worker threads have stopped
+void cleanUpConcurrent(struct ConcurrentHashTable* ct) {
+    for (int i = 0; i < MAX_THREADS; i++) {
+        for (int j = 0; j < 3; j++) freeRetiredList(ct->threads[i].limbo[j]);
+    }
+    freeBucketArray(atomic_load(&ct->table));
+    for (int i = 0; i < LOCK_STRIPES; i++) pthread_mutex_destroy(&ct->stripes[i]);
+    pthread_mutex_destroy(&ct->resizeLock);
+    free(ct);
+}
+
+// --- 8. ROBIN HOOD TABLE (Backward-Shift Deletion) ---
+
+// Linear probing where an entry that has travelled further from its home
+// slot takes the place of one that has travelled less ("rob the rich").
+// That keeps probe lengths short and even, and gives two useful invariants:
+//   - Lookup: if the slot we reach holds an entry closer to its home than
+//     we are to ours, our key cannot be further along, so a miss stops early.
+//   - Delete: shift the following displaced entries back one slot instead of
+//     leaving a tombstone, so churn never degrades the table.
+// dist[i] is (probe distance + 1) of the entry in slot i, 0 means empty.
+
+#define RH_MAX_LOAD_NUM 9       // Max load factor 9/10
+#define RH_MAX_LOAD_DEN 10
+#define RH_MAX_DIST 255         // dist[] is a byte; hitting this forces a grow
+
+struct RobinHoodTable {
+    struct Slot* slots;
+    unsigned char* dist;
+    int capacity;  // Power of two
+    int size;
+    int maxDist;   // Longest probe distance + 1 present; bounds every lookup
+    int distCount[RH_MAX_DIST + 1]; // Entries per dist[] value, keeps maxDist exact
+};
+
+struct RobinHoodTable* createRobinHoodTable(int capacity) {
+    int cap = 16;
+    while (cap < capacity) cap *= 2;
+
+    struct RobinHoodTable* rt = (struct RobinHoodTable*)malloc(sizeof(struct RobinHoodTable));
+    rt->capacity = cap;
+    rt->size = 0;
+    rt->maxDist = 0;
+    memset(rt->distCount, 0, sizeof(rt->distCount));
+    rt->slots = (struct Slot*)malloc(sizeof(struct Slot) * cap);
+    rt->dist = (unsigned char*)calloc(cap, 1);
+    return rt;
+}
+
+static inline int rhHome(struct RobinHoodTable* rt, int key) {
+    return hashIndex(ROBIN_HOOD_HASH((unsigned int)key), rt->capacity);
+}
+
+// Returns the slot holding 'key', or -1
+static int rhFind(struct RobinHoodTable* rt, int key) {
+    int mask = rt->capacity - 1;
+    int i = rhHome(rt, key);
+    for (int d = 1; d <= rt->maxDist; d++) {
+        if (rt->dist[i] < d) return -1; // Empty, or a richer entry: early exit
+        if (rt->dist[i] == d && rt->slots[i].key == key) return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+static void rhResize(struct RobinHoodTable* rt, int newCapacity);
+
+// Places a key known to be absent. Returns false if a probe distance would
+// overflow the byte metadata (caller grows and retries).
+static bool rhPlace(struct RobinHoodTable* rt, struct Slot entry) {
+    int mask = rt->capacity - 1;
+    int i = rhHome(rt, entry.key);
+    int d = 1;
+
+    while (1) {
+        if (rt->dist[i] == 0) {
+            rt->slots[i] = entry;
+            rt->dist[i] = (unsigned char)d;
+            rt->distCount[d]++;
+            if (d > rt->maxDist) rt->maxDist = d;
+            rt->size++;
+            return true;
+        }
+        if (rt->dist[i] < d) {
+            // The resident is closer to home than we are: swap and carry it on
+            struct Slot tmpSlot = rt->slots[i];
+            int tmpDist = rt->dist[i];
+            rt->slots[i] = entry;
+            rt->dist[i] = (unsigned char)d;
+            rt->distCount[tmpDist]--;
+            rt->distCount[d]++;
+            if (d > rt->maxDist) rt->maxDist = d;
+            entry = tmpSlot;
+            d = tmpDist;
+        }
+        if (++d >= RH_MAX_DIST) {
+            // Put the carried entry back through a bigger table
+            rhResize(rt, rt->capacity * 2);
+            return rhPlace(rt, entry);
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static void rhResize(struct RobinHoodTable* rt, int newCapacity) {
+    struct Slot* oldSlots = rt->slots;
+    unsigned char* oldDist = rt->dist;
+    int oldCapacity = rt->capacity;
+
+    rt->capacity = newCapacity;
+    rt->size = 0;
+    rt->maxDist = 0;
+    memset(rt->distCount, 0, sizeof(rt->distCount));
+    rt->slots = (struct Slot*)malloc(sizeof(struct Slot) * newCapacity);
+    rt->dist = (unsigned char*)calloc(newCapacity, 1);
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldDist[i] != 0) rhPlace(rt, oldSlots[i]);
+    }
+    free(oldSlots);
+    free(oldDist);
+}
+
+// INSERT (or Update if key exists)
+void robinHoodInsert(struct RobinHoodTable* rt, int key, int value) {
+    int i = rhFind(rt, key);
+    if (i >= 0) {
+        rt->slots[i].value = value;
+        return;
+    }
+    if ((rt->size + 1) * RH_MAX_LOAD_DEN > rt->capacity * RH_MAX_LOAD_NUM)
+        rhResize(rt, rt->capacity * 2);
+
+    struct Slot entry = { key, value };
+    rhPlace(rt, entry);
+}
+
+// SEARCH: Returns value or -1 if not found
+int robinHoodSearch(struct RobinHoodTable* rt, int key) {
+    int i = rhFind(rt, key);
+    return (i >= 0) ? rt->slots[i].value : -1;
+}
+
+// DELETE with backward shift: pull every following displaced entry one
+// slot closer to home until we hit an empty slot or an entry already home.
+// Probes only get shorter here, so maxDist drops to the longest one left.
+void robinHoodDeleteKey(struct RobinHoodTable* rt, int key) {
+    int i = rhFind(rt, key);
+    if (i < 0) return;
+
+    int mask = rt->capacity - 1;
+    int next = (i + 1) & mask;
+    rt->distCount[rt->dist[i]]--;
+    while (rt->dist[next] > 1) {
+        rt->slots[i] = rt->slots[next];
+        rt->dist[i] = (unsigned char)(rt->dist[next] - 1);
+        rt->distCount[rt->dist[next]]--;
+        rt->distCount[rt->dist[i]]++;
+        i = next;
+        next = (next + 1) & mask;
+    }
+    rt->dist[i] = 0;
+    rt->size--;
+    while (rt->maxDist > 0 && rt->distCount[rt->maxDist] == 0) rt->maxDist--;
+}
+
+// Average and maximum probe length (1 = found in the home slot)
+void robinHoodProbeStats(const struct RobinHoodTable* rt, double* avg, int* max) {
+    long long total = 0;
+    for (int d = 1; d <= rt->maxDist; d++) total += (long long)d * rt->distCount[d];
+    *avg = rt->size ? (double)total / rt->size : 0.0;
+    *max = rt->maxDist;
+}
+
+void cleanUpRobinHood(struct RobinHoodTable* rt) {
+    free(rt->slots);
+    free(rt->dist);
+    free(rt);
+}
+
+// --- 8b. PERSISTENT TABLE (Memory-Mapped File) ---
+
+// A read-only snapshot of a chained table stored in a file that is used in
+// place through mmap, so a restart costs one open + mmap instead of
+// re-running insert() for every key. Pages are faulted in lazily on first
+// touch. The format uses byte offsets from the start of the file, never
+// pointers, so it is valid at whatever address it gets mapped.
+//
+// Layout (version 1, host byte order, all offsets from file start):
+//   struct PersistentHeader                      (64 bytes)
+//   uint64_t bucketOffsets[capacity]             (0 = empty bucket)
+//   struct PersistentEntry entries[count]        (grouped by bucket)
+// Bucket index = hashIndex(hashMurmur64(key), capacity). The hash is part
+// of the format, so it does not follow the compile-time table policies.
+//
+// Writers build "<path>.tmp" completely, fsync it and rename() it over
+// <path>. rename is atomic, so a reader opens either the old or the new
+// version, never a half-written one; existing mappings keep the old inode.
+
+#define PERSISTENT_MAGIC 0x31544850u  // "PHT1"
+#define PERSISTENT_VERSION 1u
+
+struct PersistentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t entrySize;
+    uint64_t capacity;       // Power of two
+    uint64_t count;
+    uint64_t bucketsOffset;
+    uint64_t entriesOffset;
+    uint64_t fileSize;
+    uint64_t reserved;
+};
+
+struct PersistentEntry {
+    int32_t key;
+    int32_t value;
+    uint64_t next;           // Offset of the next entry in the chain, 0 = end
+};
+
+struct PersistentTable {
+    const unsigned char* base;  // Start of the mapping
+    size_t length;
+    const struct PersistentHeader* header;
+    const uint64_t* buckets;
+};
+
+// hashIndex() on the full 64-bit capacity the file may declare
+static inline uint64_t persistentBucket(uint64_t h, uint64_t capacity) {
+    return h >> (64 - __builtin_ctzll(capacity));
+}
+
+// Snapshot 'ht' into 'path'. Returns true on success.
+bool persistentWrite(struct HashTable* ht, const char* path) {
+    finishRehash(ht); // One bucket array to walk
+
+    uint64_t capacity = 16;
+    while (capacity < (uint64_t)ht->size * 2) capacity *= 2; // Load <= 0.5
+    uint64_t count = (uint64_t)ht->size;
+
+    struct PersistentHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PERSISTENT_MAGIC;
+    header.version = PERSISTENT_VERSION;
+    header.headerSize = sizeof(struct PersistentHeader);
+    header.entrySize = sizeof(struct PersistentEntry);
+    header.capacity = capacity;
+    header.count = count;
+    header.bucketsOffset = sizeof(struct PersistentHeader);
+    header.entriesOffset = header.bucketsOffset + capacity * sizeof(uint64_t);
+    header.fileSize = header.entriesOffset + count * sizeof(struct PersistentEntry);
+
+    // Counting sort by bucket so every chain is contiguous on disk
+    uint64_t* starts = (uint64_t*)calloc(capacity + 1, sizeof(uint64_t));
+    for (int i = 0; i < ht->capacity; i++) {
+        for (struct Node* n = ht->buckets[i]; n != NULL; n = n->next)
+            starts[persistentBucket(hashMurmur64((unsigned int)n->key), capacity) + 1]++;
+    }
+    for (uint64_t b = 0; b < capacity; b++) starts[b + 1] += starts[b];
+
+    uint64_t* buckets = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+    struct PersistentEntry* entries = (struct PersistentEntry*)calloc(count ? count : 1, sizeof(struct PersistentEntry));
+    uint64_t* fill = (uint64_t*)malloc(sizeof(uint64_t) * capacity);
+    memcpy(fill, starts, sizeof(uint64_t) * capacity);
+
+    for (int i = 0; i < ht->capacity; i++) {
+        for (struct Node* n = ht->buckets[i]; n != NULL; n = n->next) {
+            uint64_t b = persistentBucket(hashMurmur64((unsigned int)n->key), capacity);
+            uint64_t slot = fill[b]++;
+            entries[slot].key = n->key;
+            entries[slot].value = n->value;
+            entries[slot].next = (fill[b] < starts[b + 1])
+                ? header.entriesOffset + fill[b] * sizeof(struct PersistentEntry) : 0;
+        }
+    }
+    for (uint64_t b = 0; b < capacity; b++) {
+        if (starts[b] != starts[b + 1])
+            buckets[b] = header.entriesOffset + starts[b] * sizeof(struct PersistentEntry);
+    }
+
+    char tmpPath[4096];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    FILE* f = fopen(tmpPath, "wb");
+    bool ok = (f != NULL);
+    if (ok) {
+        ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+             fwrite(buckets, sizeof(uint64_t), capacity, f) == capacity &&
+             fwrite(entries, sizeof(struct PersistentEntry), count, f) == count;
+        ok = (fflush(f) == 0) && ok;
+        ok = (fsync(fileno(f)) == 0) && ok;
+        ok = (fclose(f) == 0) && ok;
+    }
+    if (ok) ok = (rename(tmpPath, path) == 0); // Atomic publish
+    if (!ok) remove(tmpPath);
+
+    free(starts);
+    free(buckets);
+    free(entries);
+    free(fill);
+    return ok;
+}
+
+// The header comes from disk, so every size is bounded before it is
+// multiplied and every region must lie inside the file, in order.
+static bool persistentHeaderValid(const struct PersistentHeader* h, uint64_t fileSize) {
+    if (h->magic != PERSISTENT_MAGIC || h->version != PERSISTENT_VERSION ||
+        h->headerSize != sizeof(struct PersistentHeader) ||
+        h->entrySize != sizeof(struct PersistentEntry) || h->fileSize != fileSize)
+        return false;
+    if (h->capacity < 16 || (h->capacity & (h->capacity - 1)) != 0) return false;
+    if (h->capacity > SIZE_MAX / sizeof(uint64_t) ||
+        h->count > SIZE_MAX / sizeof(struct PersistentEntry))
+        return false;
+    if (h->bucketsOffset < sizeof(struct PersistentHeader) || h->bucketsOffset % sizeof(uint64_t) != 0 ||
+        h->bucketsOffset > fileSize)
+        return false;
+    uint64_t bucketBytes = h->capacity * sizeof(uint64_t);
+    if (bucketBytes > fileSize - h->bucketsOffset || h->entriesOffset != h->bucketsOffset + bucketBytes)
+        return false;
+    return h->count * sizeof(struct PersistentEntry) == fileSize - h->entriesOffset;
+}
+
+// O(1) open: maps the file and checks the header, nothing is read eagerly.
+// Returns NULL if the file is missing, truncated or of another version.
+struct PersistentTable* persistentOpen(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct PersistentHeader)) {
+        close(fd);
+        return NULL;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (map == MAP_FAILED) return NULL;
+
+    const struct PersistentHeader* h = (const struct PersistentHeader*)map;
+    if (!persistentHeaderValid(h, (uint64_t)st.st_size)) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+    madvise(map, (size_t)st.st_size, MADV_RANDOM); // Lookups hop around: no readahead
+
+    struct PersistentTable* pt = (struct PersistentTable*)malloc(sizeof(struct PersistentTable));
+    pt->base = (const unsigned char*)map;
+    pt->length = (size_t)st.st_size;
+    pt->header = h;
+    pt->buckets = (const uint64_t*)(pt->base + h->bucketsOffset);
+    return pt;
+}
+
+// SEARCH: Returns value or -1 if not found (same contract as search())
+// A chain never holds more than 'count' entries, so a corrupt file with a
+// cycle in it ends the walk instead of spinning; offsets that do not land
+// on an entry end it too.
+int persistentSearch(struct PersistentTable* pt, int key) {
+    const struct PersistentHeader* h = pt->header;
+    uint64_t offset = pt->buckets[persistentBucket(hashMurmur64((unsigned int)key), h->capacity)];
+    for (uint64_t steps = 0; offset != 0 && steps < h->count; steps++) {
+        if (offset < h->entriesOffset || offset >= h->fileSize ||
+            (offset - h->entriesOffset) % sizeof(struct PersistentEntry) != 0)
+            break;
+        const struct PersistentEntry* e = (const struct PersistentEntry*)(pt->base + offset);
+        if (e->key == key) return e->value;
+        offset = e->next;
+    }
+    return -1;
+}
+
+void persistentClose(struct PersistentTable* pt) {
+    munmap((void*)pt->base, pt->length);
+    free(pt);
+}
+
+// --- 8c. NEGATIVE-LOOKUP FILTERS (Blocked Bloom, Cuckoo) ---
+
+// Most lookups in some workloads are misses, and a miss walks a whole chain.
+// A filter answers "definitely absent" from one cache line, so the table only
+// probes when the filter says "maybe". Attach one with attachBloomFilter() or
+// attachCuckooFilter(); the chained table then keeps it up to date.
+// A filter never gives a false negative; false positives just cost a probe.
+
+#ifndef FILTER_HASH
+#define FILTER_HASH hashMurmur64
+#endif
+
+#define BLOOM_BLOCK_WORDS 8        // 8 x 32 bits = one 256-bit block
+#define CUCKOO_SLOTS 4             // Fingerprints per bucket
+#define CUCKOO_MAX_KICKS 500
+#define CUCKOO_MAX_LOAD 0.95       // Filter buckets are sized for this load
+
+// Blocked Bloom filter ("split block"): a key picks one 256-bit block and
+// sets exactly one bit in each of its eight 32-bit words. A lookup is one
+// 32-byte load and one vector AND/compare instead of 8 random cache misses.
+struct BlockedBloomFilter {
+    uint32_t* blocks;  // numBlocks * BLOOM_BLOCK_WORDS words, 32-byte aligned
+    int numBlocks;
+    double bitsPerKey;
+};
+
+static const uint32_t bloomSalt[BLOOM_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+// Expected false-positive rate at 'bitsPerKey': blocks hold Poisson(256/c)
+// keys, and with j keys a word has a given bit set w.p. 1 - (31/32)^j.
+static double bloomExpectedFpr(double bitsPerKey) {
+    double lambda = 256.0 / bitsPerKey;
+    double p = exp(-lambda); // Poisson(j = 0)
+    double fpr = 0.0;
+    for (int j = 0; j < (int)(lambda * 6) + 64; j++) {
+        if (j > 0) p *= lambda / j;
+        fpr += p * pow(1.0 - pow(31.0 / 32.0, j), BLOOM_BLOCK_WORDS);
+    }
+    return fpr;
+}
+
+// Smallest bits/key meeting the target false-positive rate
+static double bloomBitsPerKey(double targetFpr) {
+    double lo = 2.0, hi = 64.0;
+    for (int i = 0; i < 40; i++) {
+        double mid = (lo + hi) / 2;
+        if (bloomExpectedFpr(mid) > targetFpr) lo = mid;
+        else hi = mid;
+    }
+    return hi;
+}
+
+struct BlockedBloomFilter* createBloomFilter(int expectedKeys, double targetFpr) {
+    struct BlockedBloomFilter* bf = (struct BlockedBloomFilter*)malloc(sizeof(struct BlockedBloomFilter));
+    bf->bitsPerKey = bloomBitsPerKey(targetFpr);
+    double bits = bf->bitsPerKey * (expectedKeys > 0 ? expectedKeys : 1);
+    int blocks = (int)ceil(bits / 256.0);
+    bf->numBlocks = blocks;
+    bf->blocks = (uint32_t*)aligned_alloc(32, sizeof(uint32_t) * BLOOM_BLOCK_WORDS * blocks);
+    memset(bf->blocks, 0, sizeof(uint32_t) * BLOOM_BLOCK_WORDS * blocks);
+    return bf;
+}
+
+// Block index from the top hash bits, bit positions from the low 32 bits
+static inline uint32_t* bloomBlock(struct BlockedBloomFilter* bf, unsigned long long h) {
+    return bf->blocks + (size_t)reduceRange(h, bf->numBlocks) * BLOOM_BLOCK_WORDS;
+}
+
+static inline void bloomMask(uint32_t lo, uint32_t mask[BLOOM_BLOCK_WORDS]) {
+    for (int i = 0; i < BLOOM_BLOCK_WORDS; i++) mask[i] = 1u << ((lo * bloomSalt[i]) >> 27);
+}
+
+void bloomAdd(struct BlockedBloomFilter* bf, int key) {
+    unsigned long long h = FILTER_HASH((unsigned int)key);
+    uint32_t* block = bloomBlock(bf, h);
+    uint32_t mask[BLOOM_BLOCK_WORDS];
+    bloomMask((uint32_t)h, mask);
+    for (int i = 0; i < BLOOM_BLOCK_WORDS; i++) block[i] |= mask[i];
+}
+
+bool bloomMayContain(struct BlockedBloomFilter* bf, int key) {
+    unsigned long long h = FILTER_HASH((unsigned int)key);
+    const uint32_t* block = bloomBlock(bf, h);
+    uint32_t mask[BLOOM_BLOCK_WORDS];
+    bloomMask((uint32_t)h, mask);
+#if defined(__AVX2__)
+    __m256i b = _mm256_load_si256((const __m256i*)block);
+    __m256i m = _mm256_loadu_si256((const __m256i*)mask);
+    return _mm256_testc_si256(b, m); // (~b & m) == 0
+#elif defined(__SSE2__)
+    __m128i m0 = _mm_loadu_si128((const __m128i*)mask);
+    __m128i m1 = _mm_loadu_si128((const __m128i*)(mask + 4));
+    __m128i b0 = _mm_and_si128(_mm_load_si128((const __m128i*)block), m0);
+    __m128i b1 = _mm_and_si128(_mm_load_si128((const __m128i*)(block + 4)), m1);
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi32(b0, m0), _mm_cmpeq_epi32(b1, m1));
+    return _mm_movemask_epi8(eq) == 0xFFFF;
+#else
+    for (int i = 0; i < BLOOM_BLOCK_WORDS; i++)
+        if ((block[i] & mask[i]) == 0) return false;
+    return true;
+#endif
+}
+
+// Bulk build: counting-sort the keys by block first, so the bits are set
+// block after block with sequential memory traffic instead of random misses.
+// Sized for max(n, expectedKeys) so later bloomAdd() calls keep the FPR.
+struct BlockedBloomFilter* bloomBulkBuild(const int* keys, int n, int expectedKeys, double targetFpr) {
+    struct BlockedBloomFilter* bf = createBloomFilter(n > expectedKeys ? n : expectedKeys, targetFpr);
+    int* start = (int*)calloc(bf->numBlocks + 1, sizeof(int));
+    unsigned long long* hashes = (unsigned long long*)malloc(sizeof(unsigned long long) * (n ? n : 1));
+    unsigned long long* sorted = (unsigned long long*)malloc(sizeof(unsigned long long) * (n ? n : 1));
+
+    for (int i = 0; i < n; i++) {
+        hashes[i] = FILTER_HASH((unsigned int)keys[i]);
+        start[reduceRange(hashes[i], bf->numBlocks) + 1]++;
+    }
+    for (int b = 0; b < bf->numBlocks; b++) start[b + 1] += start[b];
+    for (int i = 0; i < n; i++) sorted[start[reduceRange(hashes[i], bf->numBlocks)]++] = hashes[i];
+
+    for (int i = 0; i < n; i++) {
+        uint32_t* block = bloomBlock(bf, sorted[i]);
+        uint32_t mask[BLOOM_BLOCK_WORDS];
+        bloomMask((uint32_t)sorted[i], mask);
+        for (int w = 0; w < BLOOM_BLOCK_WORDS; w++) block[w] |= mask[w];
+    }
+    free(start);
+    free(hashes);
+    free(sorted);
+    return bf;
+}
+
+void destroyBloomFilter(struct BlockedBloomFilter* bf) {
+    free(bf->blocks);
+    free(bf);
+}
+
+// Cuckoo filter: each key stores a small fingerprint in one of two 4-slot
+// buckets, i1 = index(h) and i2 = (index(hash(fp)) - i1) mod n, so either
+// bucket can be computed from the other plus the fingerprint. That makes
+// delete possible, which a Bloom filter cannot do.
+// Space: fingerprints are packed at their exact width (a bucket is one
+// CUCKOO_SLOTS * fpBits <= 64 bit field) and n is sized for ~95% load
+// rather than rounded up to a power of two, so a 1% target costs about
+// 4 * 10 / 0.95 = 10.5 bits per key. One lookup = two unaligned 8-byte
+// loads and a SWAR "any field equal" test on each (x86 byte order).
+struct CuckooFilter {
+    unsigned char* bits; // numBuckets packed buckets, + 8 bytes of slack
+    int numBuckets;      // Any n >= 2: the alternate bucket is taken mod n
+    int fpBits;          // Fingerprint width set from the target FPR
+    uint16_t fpMask;
+    uint64_t bucketMask; // Low CUCKOO_SLOTS * fpBits bits
+    uint64_t slotLows;   // Lowest bit of every slot field
+    int count;
+    uint16_t victimFp;  // One homeless fingerprint after a failed insert
+    int victimBucket;
+    bool saturated;     // A second failure: answer "maybe" for everything
+    unsigned int rng;
+};
+
+static inline unsigned int cuckooRandom(struct CuckooFilter* cf) {
+    cf->rng ^= cf->rng << 13;
+    cf->rng ^= cf->rng >> 17;
+    cf->rng ^= cf->rng << 5;
+    return cf->rng;
+}
+
+// An involution for any n: alt(alt(b)) = b
+static inline int cuckooAltBucket(struct CuckooFilter* cf, int bucket, uint16_t fp) {
+    int alt = reduceRange(hashFibonacci(fp), cf->numBuckets) - bucket;
+    return alt < 0 ? alt + cf->numBuckets : alt;
+}
+
+// Bucket index from the top 32 hash bits, fingerprint from the next 16
+static inline void cuckooLocate(struct CuckooFilter* cf, int key, int* bucket, uint16_t* fp) {
+    unsigned long long h = FILTER_HASH((unsigned int)key);
+    *bucket = reduceRange(h, cf->numBuckets);
+    *fp = (uint16_t)((h >> 16) & cf->fpMask);
+    if (*fp == 0) *fp = 1; // 0 marks an empty slot
+}
+
+// Bucket 'bucket' as one word, slot s in bits [s * fpBits, (s + 1) * fpBits)
+static inline uint64_t cuckooLoad(const struct CuckooFilter* cf, int bucket) {
+    size_t bit = (size_t)bucket * CUCKOO_SLOTS * cf->fpBits;
+    const unsigned char* p = cf->bits + (bit >> 3);
+    int shift = (int)(bit & 7);
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    w >>= shift;
+    if (shift != 0 && shift + CUCKOO_SLOTS * cf->fpBits > 64) w |= (uint64_t)p[8] << (64 - shift);
+    return w & cf->bucketMask;
+}
+
+static inline void cuckooStore(struct CuckooFilter* cf, int bucket, uint64_t w) {
+    size_t bit = (size_t)bucket * CUCKOO_SLOTS * cf->fpBits;
+    unsigned char* p = cf->bits + (bit >> 3);
+    int shift = (int)(bit & 7);
+    uint64_t old;
+    memcpy(&old, p, sizeof(old));
+    old = (old & ~(cf->bucketMask << shift)) | (w << shift);
+    memcpy(p, &old, sizeof(old));
+    if (shift != 0 && shift + CUCKOO_SLOTS * cf->fpBits > 64) {
+        unsigned char spill = (unsigned char)(cf->bucketMask >> (64 - shift));
+        p[8] = (unsigned char)((p[8] & ~spill) | (w >> (64 - shift)));
+    }
+}
+
+static inline uint16_t cuckooSlot(const struct CuckooFilter* cf, uint64_t w, int s) {
+    return (uint16_t)((w >> (s * cf->fpBits)) & cf->fpMask);
+}
+
+static inline uint64_t cuckooWithSlot(const struct CuckooFilter* cf, uint64_t w, int s, uint16_t fp) {
+    int at = s * cf->fpBits;
+    return (w & ~((uint64_t)cf->fpMask << at)) | ((uint64_t)fp << at);
+}
+
+// Fingerprint bits: FPR ~ 2 * CUCKOO_SLOTS / 2^bits. At least 8: the
+// alternate bucket is one of only 2^bits offsets, and below ~7 bits the
+// random walk cannot reach CUCKOO_MAX_LOAD on large filters.
+struct CuckooFilter* createCuckooFilter(int expectedKeys, double targetFpr) {
+    struct CuckooFilter* cf = (struct CuckooFilter*)calloc(1, sizeof(struct CuckooFilter));
+    int bits = (int)ceil(log2(2.0 * CUCKOO_SLOTS / targetFpr));
+    if (bits < 8) bits = 8;
+    if (bits > 16) bits = 16;
+    cf->fpBits = bits;
+    cf->fpMask = (uint16_t)((1u << bits) - 1);
+    cf->bucketMask = (CUCKOO_SLOTS * bits == 64) ? ~0ULL : (1ULL << (CUCKOO_SLOTS * bits)) - 1;
+    for (int s = 0; s < CUCKOO_SLOTS; s++) cf->slotLows |= 1ULL << (s * bits);
+
+    int buckets = (int)ceil(expectedKeys / (CUCKOO_SLOTS * CUCKOO_MAX_LOAD));
+    if (buckets < 2) buckets = 2;
+    cf->numBuckets = buckets;
+    size_t bytes = ((size_t)buckets * CUCKOO_SLOTS * bits + 7) / 8;
+    cf->bits = (unsigned char*)calloc(bytes + 8, 1); // Slack for the 8-byte loads
+    cf->victimBucket = -1;
+    cf->rng = 0x9E3779B9u;
+    return cf;
+}
+
+static bool cuckooInsertInto(struct CuckooFilter* cf, int bucket, uint16_t fp) {
+    uint64_t w = cuckooLoad(cf, bucket);
+    for (int s = 0; s < CUCKOO_SLOTS; s++) {
+        if (cuckooSlot(cf, w, s) == 0) {
+            cuckooStore(cf, bucket, cuckooWithSlot(cf, w, s, fp));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns false only if the filter had to give up (it is then saturated)
+bool cuckooAdd(struct CuckooFilter* cf, int key) {
+    int i1;
+    uint16_t fp;
+    cuckooLocate(cf, key, &i1, &fp);
+    cf->count++;
+    if (cf->saturated) return false;
+
+    int i2 = cuckooAltBucket(cf, i1, fp);
+    if (cuckooInsertInto(cf, i1, fp) || cuckooInsertInto(cf, i2, fp)) return true;
+
+    // Both full: evict random residents along a random walk
+    int bucket = (cuckooRandom(cf) & 1) ? i1 : i2;
+    for (int kick = 0; kick < CUCKOO_MAX_KICKS; kick++) {
+        int s = (int)(cuckooRandom(cf) % CUCKOO_SLOTS);
+        uint64_t w = cuckooLoad(cf, bucket);
+        uint16_t evicted = cuckooSlot(cf, w, s);
+        cuckooStore(cf, bucket, cuckooWithSlot(cf, w, s, fp));
+        fp = evicted;
+        bucket = cuckooAltBucket(cf, bucket, fp);
+        if (cuckooInsertInto(cf, bucket, fp)) return true;
+    }
+
+    // Keep the homeless fingerprint so nothing is ever forgotten
+    if (cf->victimBucket < 0) {
+        cf->victimFp = fp;
+        cf->victimBucket = bucket;
+        return true;
+    }
+    cf->saturated = true;
+    return false;
+}
+
+// Does a bucket word hold fp? XOR zeroes the matching fields, and the
+// classic has-zero test ((x - lows) & ~x & highs) flags any zero field.
+static inline bool cuckooHas(const struct CuckooFilter* cf, uint64_t w, uint16_t fp) {
+    uint64_t x = w ^ (cf->slotLows * fp);
+    return ((x - cf->slotLows) & ~x & (cf->slotLows << (cf->fpBits - 1))) != 0;
+}
+
+static inline bool cuckooMatch(struct CuckooFilter* cf, int i1, int i2, uint16_t fp) {
+    return cuckooHas(cf, cuckooLoad(cf, i1), fp) || cuckooHas(cf, cuckooLoad(cf, i2), fp);
+}
+
+bool cuckooMayContain(struct CuckooFilter* cf, int key) {
+    if (cf->saturated) return true;
+    int i1;
+    uint16_t fp;
+    cuckooLocate(cf, key, &i1, &fp);
+    int i2 = cuckooAltBucket(cf, i1, fp);
+    if (cuckooMatch(cf, i1, i2, fp)) return true;
+    return cf->victimBucket >= 0 && cf->victimFp == fp &&
+           (cf->victimBucket == i1 || cf->victimBucket == i2);
+}
+
+// Only call for keys that were added; removes one copy of the fingerprint
+bool cuckooRemove(struct CuckooFilter* cf, int key) {
+    int i1;
+    uint16_t fp;
+    cuckooLocate(cf, key, &i1, &fp);
+    int i2 = cuckooAltBucket(cf, i1, fp);
+    cf->count--;
+    if (cf->saturated) return true;
+
+    int found = -1;
+    for (int s = 0; s < 2 * CUCKOO_SLOTS && found < 0; s++) {
+        int bucket = (s < CUCKOO_SLOTS) ? i1 : i2;
+        uint64_t w = cuckooLoad(cf, bucket);
+        if (cuckooSlot(cf, w, s % CUCKOO_SLOTS) == fp) {
+            cuckooStore(cf, bucket, cuckooWithSlot(cf, w, s % CUCKOO_SLOTS, 0));
+            found = s;
+        }
+    }
+    if (found >= 0) {
+        // A free slot now exists: try to re-home the victim
+        if (cf->victimBucket >= 0) {
+            int vb = cf->victimBucket;
+            uint16_t vfp = cf->victimFp;
+            if (cuckooInsertInto(cf, vb, vfp) || cuckooInsertInto(cf, cuckooAltBucket(cf, vb, vfp), vfp))
+                cf->victimBucket = -1;
+        }
+        return true;
+    }
+    if (cf->victimBucket >= 0 && cf->victimFp == fp && (cf->victimBucket == i1 || cf->victimBucket == i2)) {
+        cf->victimBucket = -1;
+        return true;
+    }
+    return false;
+}
+
+struct CuckooFilter* cuckooBulkBuild(const int* keys, int n, int expectedKeys, double targetFpr) {
+    struct CuckooFilter* cf = createCuckooFilter(n > expectedKeys ? n : expectedKeys, targetFpr);
+    for (int i = 0; i < n; i++) cuckooAdd(cf, keys[i]);
+    return cf;
+}
+
+void destroyCuckooFilter(struct CuckooFilter* cf) {
+    free(cf->bits);
+    free(cf);
+}
+
+// --- 8d. Attaching a filter to the chained table ---
+
+static void bloomAddOp(void* s, int key) { bloomAdd((struct BlockedBloomFilter*)s, key); }
+static bool bloomMayContainOp(void* s, int key) { return bloomMayContain((struct BlockedBloomFilter*)s, key); }
+static void bloomDestroyOp(void* s) { destroyBloomFilter((struct BlockedBloomFilter*)s); }
+
+static void cuckooAddOp(void* s, int key) { cuckooAdd((struct CuckooFilter*)s, key); }
+static bool cuckooMayContainOp(void* s, int key) { return cuckooMayContain((struct CuckooFilter*)s, key); }
+static bool cuckooRemoveOp(void* s, int key) { return cuckooRemove((struct CuckooFilter*)s, key); }
+static void cuckooDestroyOp(void* s) { destroyCuckooFilter((struct CuckooFilter*)s); }
+
+// Collects the table's current keys (both arrays during a resize)
+static int* collectKeys(struct HashTable* ht) {
+    int* keys = (int*)malloc(sizeof(int) * (ht->size ? ht->size : 1));
+    int n = 0;
+    for (int i = 0; i < ht->capacity; i++)
+        for (struct Node* c = ht->buckets[i]; c != NULL; c = c->next) keys[n++] = c->key;
+    if (ht->oldBuckets != NULL) {
+        for (int i = ht->rehashIndex; i < ht->oldCapacity; i++)
+            for (struct Node* c = ht->oldBuckets[i]; c != NULL; c = c->next) keys[n++] = c->key;
+    }
+    return keys;
+}
+
+static void replaceFilter(struct HashTable* ht, struct LookupFilter* filter) {
+    if (ht->filter != NULL) {
+        ht->filter->destroy(ht->filter->state);
+        free(ht->filter);
+    }
+    ht->filter = filter;
+}
+
+// Sizes for 'expectedKeys' (past that the false-positive rate rises).
+// Deleted keys stay set, so heavy churn also raises it.
+void attachBloomFilter(struct HashTable* ht, int expectedKeys, double targetFpr) {
+    int* keys = collectKeys(ht);
+    struct LookupFilter* f = (struct LookupFilter*)malloc(sizeof(struct LookupFilter));
+    f->state = bloomBulkBuild(keys, ht->size, expectedKeys, targetFpr);
+    f->add = bloomAddOp;
+    f->mayContain = bloomMayContainOp;
+    f->remove = NULL;
+    f->destroy = bloomDestroyOp;
+    replaceFilter(ht, f);
+    free(keys);
+}
+
+// Supports deletes. If it overflows it degrades to "maybe" (never wrong).
+void attachCuckooFilter(struct HashTable* ht, int expectedKeys, double targetFpr) {
+    int* keys = collectKeys(ht);
+    struct LookupFilter* f = (struct LookupFilter*)malloc(sizeof(struct LookupFilter));
+    f->state = cuckooBulkBuild(keys, ht->size, expectedKeys, targetFpr);
+    f->add = cuckooAddOp;
+    f->mayContain = cuckooMayContainOp;
+    f->remove = cuckooRemoveOp;
+    f->destroy = cuckooDestroyOp;
+    replaceFilter(ht, f);
+    free(keys);
+}
+
+void detachFilter(struct HashTable* ht) {
+    replaceFilter(ht, NULL);
+}
+
+// --- 8e. BUCKETIZED CUCKOO TABLE (4-Way, BFS Eviction) ---
+
+// Every key lives in one of exactly two buckets of 4 slots, so a lookup
+// reads at most two 32-byte buckets (two cache lines) and compares 8 keys,
+// however full the table is. Inserting into two full buckets moves residents
+// to their other bucket; a breadth-first search finds the shortest such
+// chain of moves, which lets the table fill past 95% before it must grow.
+// The int key itself is the in-bucket tag: one SSE2 compare checks all 4.
+// INT_MIN marks an empty slot, so a real INT_MIN key is kept on the side.
+
+#ifndef BUCKET_CUCKOO_HASH
+#define BUCKET_CUCKOO_HASH hashMurmur64
+#endif
+
+#define BC_WAYS 4
+#define BC_EMPTY INT32_MIN
+#define BC_MAX_BFS_NODES 2048    // Buckets explored before giving up and growing
+#define BC_MAX_PATH 8            // Longest eviction chain
+
+struct CuckooBucket {
+    int32_t keys[BC_WAYS];
+    int32_t values[BC_WAYS];
+} __attribute__((aligned(32)));  // Never straddles a cache line
+
+struct BcPathNode {
+    int bucket;
+    int parent;  // Queue index of the bucket we came from, -1 at a root
+    int slot;    // Slot in the parent bucket whose key moves here
+    int depth;
+};
+
+struct BucketCuckooTable {
+    struct CuckooBucket* buckets;
+    int numBuckets;
+    int size;
+    bool hasEmptyKey;            // Entry whose key is BC_EMPTY
+    int emptyKeyValue;
+    int growths;
+    double loadAtFirstGrowth;    // Load factor when BFS first failed
+};
+
+// Both buckets come from one 64-bit hash: top half and bottom half
+static inline void bcBuckets(struct BucketCuckooTable* bt, int key, int* b1, int* b2) {
+    unsigned long long h = BUCKET_CUCKOO_HASH((unsigned int)key);
+    *b1 = reduceRange(h, bt->numBuckets);
+    *b2 = reduceRange(h << 32, bt->numBuckets);
+}
+
+static inline int bcAltBucket(struct BucketCuckooTable* bt, int key, int bucket) {
+    int b1, b2;
+    bcBuckets(bt, key, &b1, &b2);
+    return bucket == b1 ? b2 : b1;
+}
+
+// Bitmask of the slots in 'b' holding 'key'
+static inline unsigned int bcMatch(const struct CuckooBucket* b, int key) {
+#ifdef __SSE2__
+    __m128i keys = _mm_load_si128((const __m128i*)b->keys);
+    return (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, _mm_set1_epi32(key))));
+#else
+    unsigned int mask = 0;
+    for (int s = 0; s < BC_WAYS; s++)
+        if (b->keys[s] == key) mask |= 1u << s;
+    return mask;
+#endif
+}
+
+static struct CuckooBucket* bcAllocBuckets(int numBuckets) {
+    struct CuckooBucket* b = (struct CuckooBucket*)aligned_alloc(32, sizeof(struct CuckooBucket) * numBuckets);
+    for (int i = 0; i < numBuckets; i++)
+        for (int s = 0; s < BC_WAYS; s++) b[i].keys[s] = BC_EMPTY;
+    return b;
+}
+
+struct BucketCuckooTable* createBucketCuckooTable(int capacity) {
+    struct BucketCuckooTable* bt = (struct BucketCuckooTable*)calloc(1, sizeof(struct BucketCuckooTable));
+    bt->numBuckets = (capacity + BC_WAYS - 1) / BC_WAYS;
+    if (bt->numBuckets < 2) bt->numBuckets = 2;
+    bt->buckets = bcAllocBuckets(bt->numBuckets);
+    return bt;
+}
+
+// Finds the bucket and slot holding 'key'
+static bool bcLocate(struct BucketCuckooTable* bt, int key, int* bucket, int* slot) {
+    int b1, b2;
+    bcBuckets(bt, key, &b1, &b2);
+    unsigned int m = bcMatch(&bt->buckets[b1], key);
+    if (m) { *bucket = b1; *slot = __builtin_ctz(m); return true; }
+    m = bcMatch(&bt->buckets[b2], key);
+    if (m) { *bucket = b2; *slot = __builtin_ctz(m); return true; }
+    return false;
+}
+
+static bool bcPlaceFree(struct CuckooBucket* b, int key, int value) {
+    unsigned int m = bcMatch(b, BC_EMPTY);
+    if (!m) return false;
+    int s = __builtin_ctz(m);
+    b->keys[s] = key;
+    b->values[s] = value;
+    return true;
+}
+
+// Moves the path ending at queue[node] one step toward the hole in 'dst',
+// starting at the free end, so every key stays in one of its own buckets.
+// If the path visits a bucket twice a slot may have changed under us; then
+// stop (the table is still valid) and let the caller grow.
+static bool bcApplyPath(struct BucketCuckooTable* bt, const struct BcPathNode* queue,
+                        int node, int slot, int dst, int key, int value) {
+    for (int at = node;; slot = queue[at].slot, at = queue[at].parent) {
+        struct CuckooBucket* from = &bt->buckets[queue[at].bucket];
+        int moving = from->keys[slot];
+        if (moving == BC_EMPTY || bcAltBucket(bt, moving, queue[at].bucket) != dst) return false;
+        if (!bcPlaceFree(&bt->buckets[dst], moving, from->values[slot])) return false;
+        from->keys[slot] = BC_EMPTY;
+        dst = queue[at].bucket;
+        if (queue[at].parent < 0) break;
+    }
+    return bcPlaceFree(&bt->buckets[dst], key, value);
+}
+
+// BFS over buckets starting from b1 and b2. Each edge moves the key in one
+// slot to its alternate bucket; the first bucket with a hole ends the search
+// with the shortest eviction chain.
+static bool bcInsertBfs(struct BucketCuckooTable* bt, int key, int value, int b1, int b2) {
+    struct BcPathNode queue[BC_MAX_BFS_NODES];
+    int head = 0, tail = 0;
+    queue[tail++] = (struct BcPathNode){ b1, -1, -1, 0 };
+    if (b2 != b1) queue[tail++] = (struct BcPathNode){ b2, -1, -1, 0 };
+
+    while (head < tail) {
+        int node = head++;
+        if (queue[node].depth >= BC_MAX_PATH) continue;
+        struct CuckooBucket* b = &bt->buckets[queue[node].bucket];
+        for (int s = 0; s < BC_WAYS && tail < BC_MAX_BFS_NODES; s++) {
+            int alt = bcAltBucket(bt, b->keys[s], queue[node].bucket);
+            if (alt == queue[node].bucket) continue;
+            if (bcMatch(&bt->buckets[alt], BC_EMPTY))
+                return bcApplyPath(bt, queue, node, s, alt, key, value);
+            queue[tail++] = (struct BcPathNode){ alt, node, s, queue[node].depth + 1 };
+        }
+    }
+    return false;
+}
+
+static bool bcInsertNew(struct BucketCuckooTable* bt, int key, int value) {
+    int b1, b2;
+    bcBuckets(bt, key, &b1, &b2);
+    if (bcPlaceFree(&bt->buckets[b1], key, value) || bcPlaceFree(&bt->buckets[b2], key, value)) return true;
+    return bcInsertBfs(bt, key, value, b1, b2);
+}
+
+static void bcGrow(struct BucketCuckooTable* bt) {
+    struct CuckooBucket* old = bt->buckets;
+    int oldBuckets = bt->numBuckets;
+    if (bt->growths++ == 0) bt->loadAtFirstGrowth = (double)bt->size / (oldBuckets * BC_WAYS);
+
+    for (int newBuckets = oldBuckets * 2;; newBuckets *= 2) {
+        bt->numBuckets = newBuckets;
+        bt->buckets = bcAllocBuckets(newBuckets);
+        bool ok = true;
+        for (int i = 0; i < oldBuckets && ok; i++)
+            for (int s = 0; s < BC_WAYS && ok; s++)
+                if (old[i].keys[s] != BC_EMPTY) ok = bcInsertNew(bt, old[i].keys[s], old[i].values[s]);
+        if (ok) break;
+        free(bt->buckets);
+    }
+    free(old);
+}
+
+void bucketCuckooInsert(struct BucketCuckooTable* bt, int key, int value) {
+    if (key == BC_EMPTY) {
+        if (!bt->hasEmptyKey) bt->size++;
+        bt->hasEmptyKey = true;
+        bt->emptyKeyValue = value;
+        return;
+    }
+    int bucket, slot;
+    if (bcLocate(bt, key, &bucket, &slot)) { bt->buckets[bucket].values[slot] = value; return; }
+    while (!bcInsertNew(bt, key, value)) bcGrow(bt);
+    bt->size++;
+}
+
+// Two bucket reads at most, no matter the load
+int bucketCuckooSearch(struct BucketCuckooTable* bt, int key) {
+    if (key == BC_EMPTY) return bt->hasEmptyKey ? bt->emptyKeyValue : -1;
+    int bucket, slot;
+    return bcLocate(bt, key, &bucket, &slot) ? bt->buckets[bucket].values[slot] : -1;
+}
+
+void bucketCuckooDeleteKey(struct BucketCuckooTable* bt, int key) {
+    if (key == BC_EMPTY) {
+        if (bt->hasEmptyKey) bt->size--;
+        bt->hasEmptyKey = false;
+        return;
+    }
+    int bucket, slot;
+    if (!bcLocate(bt, key, &bucket, &slot)) return;
+    bt->buckets[bucket].keys[slot] = BC_EMPTY;
+    bt->size--;
+}
+
+double bucketCuckooLoadFactor(struct BucketCuckooTable* bt) {
+    return (double)bt->size / (bt->numBuckets * BC_WAYS);
+}
+
+void cleanUpBucketCuckoo(struct BucketCuckooTable* bt) {
+    free(bt->buckets);
+    free(bt);
+}
+
+// --- 9. BENCHMARKS ---
+
+static double elapsedSeconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Simple xorshift so the benchmark does not depend on rand()'s range
+static unsigned int benchRandom(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+void benchmarkFlatVsChained(int n) {
+    int* keys = (int*)malloc(sizeof(int) * n);
+    unsigned int seed = 12345;
+    for (int i = 0; i < n; i++) keys[i] = (int)(benchRandom(&seed) & 0x3FFFFFFF);
+
+    int savedVerbose = verbose;
+    verbose = 0;
+
+    struct HashTable* ht = createTable(INITIAL_CAPACITY);
+    struct FlatHashTable* ft = createFlatTable(FLAT_MIN_CAPACITY);
+    for (int i = 0; i < n; i++) {
+        insert(ht, keys[i], i);
+        flatInsert(ft, keys[i], i);
+    }
+
+    // Hits use the inserted keys; misses use keys with the top bit pattern
+    // that was masked off above, so they can never be present.
+    long long checksum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) checksum += search(ht, keys[i]);
+    for (int i = 0; i < n; i++) checksum += search(ht, keys[i] | 0x40000000);
+    double chainedTime = elapsedSeconds(start);
+
+    start = clock();
+    for (int i = 0; i < n; i++) checksum -= flatSearch(ft, keys[i]);
+    for (int i = 0; i < n; i++) checksum -= flatSearch(ft, keys[i] | 0x40000000);
+    double flatTime = elapsedSeconds(start);
+
+    printf("\n--- Lookup Benchmark (%d keys, %d hits + %d misses) ---\n", n, n, n);
+    printf("Chained (separate chaining): %8.2f ns/lookup\n", chainedTime * 1e9 / (2.0 * n));
+    printf("Flat (SIMD group probing):   %8.2f ns/lookup\n", flatTime * 1e9 / (2.0 * n));
+    if (flatTime > 0) printf("Speedup: %.2fx\n", chainedTime / flatTime);
+    printf("Results agree: %s\n", checksum == 0 ? "yes" : "NO");
+
+    verbose = savedVerbose;
+    cleanUp(ht);
+    cleanUpFlat(ft);
+    free(keys);
+}
+
+// Inserts n keys into a blocking and an incremental table and prints the
+// latency histograms; the blocking table's p999/max show the resize spikes.
+void benchmarkRehashLatency(int n) {
+    int savedVerbose = verbose;
+    verbose = 0;
+
+    struct HashTable* blocking = createTable(INITIAL_CAPACITY);
+    struct HashTable* incremental = createIncrementalTable(INITIAL_CAPACITY);
+    enableLatencyTracking(blocking);
+    enableLatencyTracking(incremental);
+
+    unsigned int seed = 777;
+    for (int i = 0; i < n; i++) {
+        int key = (int)(benchRandom(&seed) & 0x3FFFFFFF);
+        insert(blocking, key, i);
+        insert(incremental, key, i);
+        if ((i & 3) == 0) {
+            search(blocking, key);
+            search(incremental, key);
+        }
+    }
+
+    printf("\n--- Resize Latency (%d inserts) ---\n", n);
+    printf("[Blocking rehash]\n");
+    printLatencyReport(blocking);
+    printf("[Incremental rehash, %d buckets/op]\n", REHASH_STEP_BUCKETS);
+    printLatencyReport(incremental);
+
+    verbose = savedVerbose;
+    cleanUp(blocking);
+    cleanUp(incremental);
+}
+
+// YCSB-style mixed workload: uniform keys over a preloaded key space; a
+// "write" is an insert or a delete with equal odds, so the table both grows
+// and exercises reclamation. The baseline is the chained table behind one
+// global mutex, which is how it would have to be shared today.
+
+struct YcsbArgs {
+    struct ConcurrentHashTable* ct;   // NULL -> use the locked chained table
+    struct HashTable* ht;
+    pthread_mutex_t* globalLock;
+    int readPercent;
+    int ops;
+    int keySpace;
+    unsigned int seed;
+    long long checksum;
+};
+
+static void* ycsbWorker(void* p) {
+    struct YcsbArgs* a = (struct YcsbArgs*)p;
+    int tid = a->ct ? concurrentRegisterThread(a->ct) : 0;
+    unsigned int seed = a->seed;
+    long long sum = 0;
+
+    for (int i = 0; i < a->ops; i++) {
+        unsigned int r = benchRandom(&seed);
+        int key = (int)(r % (unsigned int)a->keySpace);
+        int isRead = (int)((r >> 8) % 100) < a->readPercent;
+
+        if (a->ct) {
+            if (isRead) sum += concurrentSearch(a->ct, tid, key);
+            else if (r & (1u << 30)) concurrentInsert(a->ct, tid, key, i);
+            else concurrentDeleteKey(a->ct, tid, key);
+        } else {
+            pthread_mutex_lock(a->globalLock);
+            if (isRead) sum += search(a->ht, key);
+            else if (r & (1u << 30)) insert(a->ht, key, i);
+            else deleteKey(a->ht, key);
+            pthread_mutex_unlock(a->globalLock);
+        }
+    }
+    a->checksum = sum;
+    return NULL;
+}
+
+static double runYcsb(int threads, int readPercent, int opsPerThread, int keySpace, bool concurrent) {
+    struct ConcurrentHashTable* ct = NULL;
+    struct HashTable* ht = NULL;
+    pthread_mutex_t globalLock;
+    pthread_mutex_init(&globalLock, NULL);
+
+    if (concurrent) {
+        ct = createConcurrentTable(keySpace);
+        int tid = concurrentRegisterThread(ct);
+        for (int k = 0; k < keySpace; k += 2) concurrentInsert(ct, tid, k, k);
+    } else {
+        ht = createTable(INITIAL_CAPACITY);
+        for (int k = 0; k < keySpace; k += 2) insert(ht, k, k);
+    }
+
+    pthread_t* ids = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+    struct YcsbArgs* args = (struct YcsbArgs*)malloc(sizeof(struct YcsbArgs) * threads);
+    unsigned long long start = nowNs();
+    for (int t = 0; t < threads; t++) {
+        args[t].ct = ct;
+        args[t].ht = ht;
+        args[t].globalLock = &globalLock;
+        args[t].readPercent = readPercent;
+        args[t].ops = opsPerThread;
+        args[t].keySpace = keySpace;
+        args[t].seed = 2463534242u + 7919u * t;
+        pthread_create(&ids[t], NULL, ycsbWorker, &args[t]);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(ids[t], NULL);
+    double seconds = (nowNs() - start) / 1e9;
+
+    if (ct) cleanUpConcurrent(ct);
+    if (ht) cleanUp(ht);
+    pthread_mutex_destroy(&globalLock);
+    free(ids);
+    free(args);
+    return (double)threads * opsPerThread / seconds / 1e6; // Mops/s
+}
+
+void benchmarkConcurrent(int threads) {
+    int savedVerbose = verbose;
+    verbose = 0;
+    if (threads > MAX_THREADS - 1) threads = MAX_THREADS - 1; // One slot is used for preloading
+
+    const int keySpace = 1 << 20;
+    const int opsPerThread = 200000;
+    const int mixes[2] = { 95, 50 };
+
+    printf("\n--- YCSB-style Benchmark (%d threads, %d keys, %d ops/thread) ---\n",
+           threads, keySpace, opsPerThread);
+    printf("%-22s %16s %16s\n", "workload (read/write)", "global lock", "striped+EBR");
+    for (int m = 0; m < 2; m++) {
+        double locked = runYcsb(threads, mixes[m], opsPerThread, keySpace, false);
+        double striped = runYcsb(threads, mixes[m], opsPerThread, keySpace, true);
+        printf("%2d/%-19d %11.2f Mops %11.2f Mops\n", mixes[m], 100 - mixes[m], locked, striped);
+    }
+    verbose = savedVerbose;
+}
+
+// Fills a Robin Hood table to ~85% and then runs delete-one/insert-one
+// cycles. With backward shift the probe lengths must stay flat; with
+// tombstones they would creep up until the next rehash.
+void benchmarkRobinHoodChurn(long long cycles) {
+    const int live = 890000; // ~85% of 2^20 slots
+    struct RobinHoodTable* rt = createRobinHoodTable(1 << 20);
+    int* keys = (int*)malloc(sizeof(int) * live);
+    unsigned int seed = 4242;
+
+    for (int i = 0; i < live; i++) {
+        do { keys[i] = (int)(benchRandom(&seed) & 0x7FFFFFFF); } while (robinHoodSearch(rt, keys[i]) != -1);
+        robinHoodInsert(rt, keys[i], i);
+    }
+
+    double avg;
+    int max;
+    robinHoodProbeStats(rt, &avg, &max);
+    printf("\n--- Robin Hood Churn (%d live keys, capacity %d, %lld cycles) ---\n", live, rt->capacity, cycles);
+    printf("%14s %10s %10s %10s\n", "cycles", "avg probe", "max probe", "capacity");
+    printf("%14d %10.3f %10d %10d\n", 0, avg, max, rt->capacity);
+
+    clock_t start = clock();
+    long long report = cycles / 10 > 0 ? cycles / 10 : 1;
+    for (long long c = 1; c <= cycles; c++) {
+        int victim = (int)(benchRandom(&seed) % live);
+        robinHoodDeleteKey(rt, keys[victim]);
+
+        int fresh;
+        do { fresh = (int)(benchRandom(&seed) & 0x7FFFFFFF); } while (robinHoodSearch(rt, fresh) != -1);
+        robinHoodInsert(rt, fresh, victim);
+        keys[victim] = fresh;
+
+        if (c % report == 0) {
+            robinHoodProbeStats(rt, &avg, &max);
+            printf("%14lld %10.3f %10d %10d\n", c, avg, max, rt->capacity);
+        }
+    }
+    double seconds = elapsedSeconds(start);
+    printf("%.1f ns per insert+delete cycle\n", seconds * 1e9 / (cycles > 0 ? cycles : 1));
+
+    cleanUpRobinHood(rt);
+    free(keys);
+}
+
+// Hash quality and speed report:
+//   ns/hash    : 10M sequential keys, hash inlined into the loop
+//   avalanche  : worst |P(output bit flips) - 0.5| * 2 over the top 32 output
+//                bits when one input bit is flipped (0 is ideal)
+//   chi^2/df   : 2^20 keys into 2^16 buckets by top bits, sequential and
+//                strided ids. About 1 matches a random spread, below 1 is even
+//                more uniform, far above 1 means clustering.
+
+#define HASH_BENCH_BUCKET_BITS 16
+#define HASH_BENCH_KEYS (1 << 20)
+
+// One timing loop per hash so the call is inlined, as it is in the tables
+#define DEFINE_HASH_TIMER(fn)                                            \
+    static double time_##fn(int n) {                                     \
+        unsigned long long sink = 0;                                     \
+        unsigned long long start = nowNs();                              \
+        for (int i = 0; i < n; i++) sink ^= fn((unsigned long long)i);   \
+        double ns = (double)(nowNs() - start) / n;                       \
+        if (sink == 42) printf(" ");  /* Keep the loop alive */          \
+        return ns;                                                       \
+    }
+
+DEFINE_HASH_TIMER(hashFibonacci)
+DEFINE_HASH_TIMER(hashMultiplyShift)
+DEFINE_HASH_TIMER(hashMurmur64)
+DEFINE_HASH_TIMER(hashWy64)
+DEFINE_HASH_TIMER(hashXxh3_64)
+
+static double avalancheBias(unsigned long long (*fn)(unsigned long long)) {
+    static long long flips[32][32];
+    const int samples = 20000;
+    unsigned int seed = 99;
+    memset(flips, 0, sizeof(flips));
+
+    for (int s = 0; s < samples; s++) {
+        unsigned int key = benchRandom(&seed);
+        unsigned long long base = fn(key) >> 32;
+        for (int in = 0; in < 32; in++) {
+            unsigned long long diff = base ^ (fn(key ^ (1u << in)) >> 32);
+            for (int out = 0; out < 32; out++) flips[in][out] += (diff >> out) & 1;
+        }
+    }
+
+    double worst = 0.0;
+    for (int in = 0; in < 32; in++) {
+        for (int out = 0; out < 32; out++) {
+            double bias = fabs((double)flips[in][out] / samples - 0.5) * 2.0;
+            if (bias > worst) worst = bias;
+        }
+    }
+    return worst;
+}
+
+// fn == NULL means the textbook key % buckets
+static double bucketChiSquare(unsigned long long (*fn)(unsigned long long), unsigned int stride) {
+    const int buckets = 1 << HASH_BENCH_BUCKET_BITS;
+    int* counts = (int*)calloc(buckets, sizeof(int));
+
+    for (unsigned int i = 0; i < HASH_BENCH_KEYS; i++) {
+        unsigned int key = i * stride;
+        int b = fn ? hashIndex(fn(key), buckets) : (int)(key % (unsigned int)buckets);
+        counts[b]++;
+    }
+
+    double expected = (double)HASH_BENCH_KEYS / buckets;
+    double chi = 0.0;
+    for (int b = 0; b < buckets; b++) chi += (counts[b] - expected) * (counts[b] - expected) / expected;
+    free(counts);
+    return chi / (buckets - 1);
+}
+
+static double timeModulo(int n, volatile int buckets) {
+    unsigned long long sink = 0;
+    unsigned long long start = nowNs();
+    for (int i = 0; i < n; i++) sink ^= (unsigned int)i % (unsigned int)buckets; // Real division
+    double ns = (double)(nowNs() - start) / n;
+    if (sink == 42) printf(" ");
+    return ns;
+}
+
+static double timeStringHash(unsigned long long (*fn)(const char*, size_t), int n) {
+    static char keys[1024][32];
+    for (int k = 0; k < 1024; k++) snprintf(keys[k], sizeof(keys[k]), "customer-id-%010d", k * 7919);
+    size_t len = strlen(keys[0]);
+    unsigned long long sink = 0;
+    unsigned long long start = nowNs();
+    for (int i = 0; i < n; i++) sink ^= fn(keys[i & 1023], len);
+    double ns = (double)(nowNs() - start) / n;
+    if (sink == 42) printf(" ");
+    return ns;
+}
+
+void benchmarkHashFunctions(void) {
+    struct {
+        const char* name;
+        unsigned long long (*fn)(unsigned long long);
+        double (*timer)(int);
+    } hashes[] = {
+        { "fibonacci",      hashFibonacci,     time_hashFibonacci },
+        { "multiply-shift", hashMultiplyShift, time_hashMultiplyShift },
+        { "murmur3 fmix64", hashMurmur64,      time_hashMurmur64 },
+        { "wyhash-style",   hashWy64,          time_hashWy64 },
+        { "xxh3-style",     hashXxh3_64,       time_hashXxh3_64 },
+    };
+    const int timed = 10000000;
+    const int buckets = 1 << HASH_BENCH_BUCKET_BITS;
+
+    printf("\n--- Hash Functions: Quality and Speed ---\n");
+    printf("%-16s %9s %11s %14s %14s\n", "hash", "ns/hash", "avalanche", "chi2/df seq", "chi2/df x4096");
+    printf("%-16s %9.2f %11s %14.2f %14.2f\n", "modulo", timeModulo(timed, buckets), "n/a",
+           bucketChiSquare(NULL, 1), bucketChiSquare(NULL, 4096));
+    for (size_t i = 0; i < sizeof(hashes) / sizeof(hashes[0]); i++) {
+        printf("%-16s %9.2f %11.4f %14.2f %14.2f\n", hashes[i].name, hashes[i].timer(timed),
+               avalancheBias(hashes[i].fn), bucketChiSquare(hashes[i].fn, 1), bucketChiSquare(hashes[i].fn, 4096));
+    }
+    printf("String hashes (22-byte keys): FNV-1a %.2f ns, wyhash-style %.2f ns\n",
+           timeStringHash(hashStringFnv1a, timed), timeStringHash(hashStringWy, timed));
+}
+
+// Startup cost: rebuilding n keys through insert() vs opening a snapshot
+void benchmarkPersistentStartup(int n, const char* path) {
+    int savedVerbose = verbose;
+    verbose = 0;
+
+    int* keys = (int*)malloc(sizeof(int) * n);
+    unsigned int seed = 2024;
+    for (int i = 0; i < n; i++) keys[i] = (int)(benchRandom(&seed) & 0x7FFFFFFF);
+
+    unsigned long long start = nowNs();
+    struct HashTable* ht = createTable(INITIAL_CAPACITY);
+    for (int i = 0; i < n; i++) insert(ht, keys[i], i);
+    double rebuildMs = (nowNs() - start) / 1e6;
+
+    if (!persistentWrite(ht, path)) {
+        printf("Could not write %s\n", path);
+        cleanUp(ht);
+        free(keys);
+        verbose = savedVerbose;
+        return;
+    }
+
+    start = nowNs();
+    struct PersistentTable* pt = persistentOpen(path);
+    double openMs = (nowNs() - start) / 1e6;
+    if (pt == NULL) {
+        printf("Could not open %s\n", path);
+        cleanUp(ht);
+        free(keys);
+        verbose = savedVerbose;
+        return;
+    }
+
+    int mismatches = 0;
+    start = nowNs();
+    for (int i = 0; i < n; i++) {
+        if (persistentSearch(pt, keys[i]) != search(ht, keys[i])) mismatches++;
+    }
+    double verifyMs = (nowNs() - start) / 1e6;
+
+    printf("\n--- Startup: Rebuild vs mmap Open (%d keys, %s) ---\n", n, path);
+    printf("Rebuild through insert(): %10.2f ms\n", rebuildMs);
+    printf("persistentOpen():         %10.3f ms\n", openMs);
+    printf("Verify all keys (faults pages in lazily): %.2f ms, mismatches: %d\n", verifyMs, mismatches);
+
+    persistentClose(pt);
+    cleanUp(ht);
+    free(keys);
+    verbose = savedVerbose;
+}
+
+// Mostly-miss lookups through the chained table with no filter, a blocked
+// Bloom filter and a cuckoo filter. Present keys are random even numbers,
+// a miss is a present key + 1.
+static double timeMissHeavyLookups(struct HashTable* ht, const int* queries, int q, long long* checksum) {
+    long long sum = 0;
+    unsigned long long start = nowNs();
+    for (int i = 0; i < q; i++) sum += search(ht, queries[i]);
+    *checksum = sum;
+    return (double)(nowNs() - start) / q;
+}
+
+static double observedFpr(struct LookupFilter* f, const int* queries, int q) {
+    int misses = 0, passed = 0;
+    for (int i = 0; i < q; i++) {
+        if ((queries[i] & 1) == 0) continue;
+        misses++;
+        if (f->mayContain(f->state, queries[i])) passed++;
+    }
+    return misses ? (double)passed / misses : 0.0;
+}
+
+void benchmarkNegativeLookups(int n, double missRatio, double targetFpr) {
+    int savedVerbose = verbose;
+    verbose = 0;
+
+    int q = 4 * n;
+    int* keys = (int*)malloc(sizeof(int) * n);
+    int* queries = (int*)malloc(sizeof(int) * q);
+    unsigned int seed = 777;
+    struct HashTable* ht = createTable(INITIAL_CAPACITY);
+    for (int i = 0; i < n; i++) {
+        keys[i] = (int)(benchRandom(&seed) & 0x7FFFFFFE);
+        insert(ht, keys[i], i);
+    }
+    for (int i = 0; i < q; i++) {
+        int k = keys[benchRandom(&seed) % (unsigned)n];
+        queries[i] = ((benchRandom(&seed) % 10000) < missRatio * 10000) ? k + 1 : k;
+    }
+
+    printf("\n--- Negative Lookups (%d keys, %d queries, %.0f%% misses, target FPR %.3f%%) ---\n",
+           n, q, missRatio * 100, targetFpr * 100);
+    printf("%-14s %10s %12s %12s %10s\n", "Front", "ns/lookup", "FPR", "bits/key", "checksum");
+
+    long long plainSum, sum;
+    double ns = timeMissHeavyLookups(ht, queries, q, &plainSum);
+    printf("%-14s %10.1f %12s %12s %10s\n", "none", ns, "-", "-", "ok");
+
+    attachBloomFilter(ht, n, targetFpr);
+    struct BlockedBloomFilter* bf = (struct BlockedBloomFilter*)ht->filter->state;
+    ns = timeMissHeavyLookups(ht, queries, q, &sum);
+    printf("%-14s %10.1f %11.3f%% %12.1f %10s\n", "blocked bloom", ns,
+           observedFpr(ht->filter, queries, q) * 100,
+           bf->numBlocks * 256.0 / n, sum == plainSum ? "ok" : "MISMATCH");
+
+    attachCuckooFilter(ht, n, targetFpr);
+    struct CuckooFilter* cf = (struct CuckooFilter*)ht->filter->state;
+    ns = timeMissHeavyLookups(ht, queries, q, &sum);
+    printf("%-14s %10.1f %11.3f%% %12.1f %10s\n", "cuckoo", ns,
+           observedFpr(ht->filter, queries, q) * 100,
+           (double)cf->numBuckets * CUCKOO_SLOTS * cf->fpBits / n, sum == plainSum ? "ok" : "MISMATCH");
+
+    // The cuckoo filter follows deletes: drop half the keys and re-check
+    for (int i = 0; i < n; i += 2) deleteKey(ht, keys[i]);
+    int falseNegatives = 0;
+    for (int i = 1; i < n; i += 2)
+        if (search(ht, keys[i]) != -1 && !cuckooMayContain(cf, keys[i])) falseNegatives++;
+    printf("After deleting half the keys: cuckoo load %.1f%%, false negatives: %d%s\n",
+           100.0 * cf->count / (cf->numBuckets * CUCKOO_SLOTS), falseNegatives,
+           cf->saturated ? " (saturated)" : "");
+
+    cleanUp(ht);
+    free(keys);
+    free(queries);
+    verbose = savedVerbose;
+}
+
+// Fill a fixed-size table until the first BFS failure to find the reachable
+// load, then time single lookups (hits and misses) at that load against the
+// chained table. Timings include one clock read (~20 ns) per lookup.
+void benchmarkBucketCuckoo(int slots) {
+    int savedVerbose = verbose;
+    verbose = 0;
+
+    struct BucketCuckooTable* bt = createBucketCuckooTable(slots);
+    int* keys = (int*)malloc(sizeof(int) * slots);
+    unsigned int seed = 31337;
+    int n = 0;
+    while (bt->growths == 0) {
+        int k = (int)(benchRandom(&seed) & 0x7FFFFFFE);
+        if (bucketCuckooSearch(bt, k) != -1) continue;
+        bucketCuckooInsert(bt, k, n);
+        if (bt->growths == 0) keys[n++] = k;
+    }
+    cleanUpBucketCuckoo(bt);
+
+    // Rebuild at exactly the reachable load so lookups run at that occupancy
+    bt = createBucketCuckooTable(slots);
+    struct HashTable* ht = createTable(INITIAL_CAPACITY);
+    for (int i = 0; i < n; i++) {
+        bucketCuckooInsert(bt, keys[i], i);
+        insert(ht, keys[i], i);
+    }
+
+    printf("\n--- Bucketized Cuckoo (%d slots, %d-way, BFS eviction) ---\n", bt->numBuckets * BC_WAYS, BC_WAYS);
+    printf("Max load before first growth: %.2f%% (%d keys), growths on rebuild: %d\n",
+           bucketCuckooLoadFactor(bt) * 100, n, bt->growths);
+    printf("Memory: %.1f bytes/entry (chained: %.1f)\n",
+           (double)sizeof(struct CuckooBucket) * bt->numBuckets / n,
+           (double)(sizeof(struct Node) + sizeof(struct Node*) * ht->capacity / (double)n));
+
+    struct LatencyHistogram lat[4];
+    memset(lat, 0, sizeof(lat));
+    int errors = 0;
+    long long sink = 0;
+    for (int i = 0; i < 2000000; i++) {
+        int k = keys[benchRandom(&seed) % (unsigned)n];
+        int miss = i & 1; // Odd keys are never inserted
+        unsigned long long start = nowNs();
+        int r = bucketCuckooSearch(bt, k + miss);
+        histogramAdd(&lat[miss], nowNs() - start);
+        start = nowNs();
+        int c = search(ht, k + miss);
+        histogramAdd(&lat[2 + miss], nowNs() - start);
+        if (r != c) errors++;
+        sink += r;
+    }
+
+    static const char* names[4] = { "cuckoo hit", "cuckoo miss", "chained hit", "chained miss" };
+    printf("%-13s %10s %10s %10s %12s\n", "lookup", "p50(ns)", "p99(ns)", "p999(ns)", "max(ns)");
+    for (int i = 0; i < 4; i++)
+        printf("%-13s %10llu %10llu %10llu %12llu\n", names[i], latencyPercentile(&lat[i], 0.50),
+               latencyPercentile(&lat[i], 0.99), latencyPercentile(&lat[i], 0.999), lat[i].maxNs);
+    printf("Mismatches vs chained table: %d%s\n", errors, sink == 42 ? " " : "");
+
+    cleanUpBucketCuckoo(bt);
+    cleanUp(ht);
+    free(keys);
+    verbose = savedVerbose;
+}
+
+// --- 10. MAIN DRIVER ---
+
+int main() {
+    struct HashTable* ht = createTable(INITIAL_CAPACITY);
+    int choice, key, val, result;
+
+    printf("=== MASTER HASH TABLE (Separate Chaining) ===\n");
+
+    while (1) {
+        printf("\n1. Insert (Key, Value)\n2. Search (Key)\n");
+        printf("3. Delete (Key)\n4. Display Table\n");
+        printf("5. Benchmark: Chained vs Flat (SIMD) Lookups\n");
+        printf("6. Benchmark: Blocking vs Incremental Resize Latency\n");
+        printf("7. Benchmark: Concurrent Table, 32 Threads (YCSB 95/5, 50/50)\n");
+        printf("8. Benchmark: Robin Hood Churn (100M insert/delete cycles)\n");
+        printf("9. Benchmark: Hash Function Quality and Speed\n");
+        printf("10. Save Table Snapshot (%s)\n11. Search Saved Snapshot (mmap)\n", SNAPSHOT_FILE);
+        printf("12. Benchmark: Rebuild vs mmap Open Startup\n");
+        printf("13. Benchmark: Bloom vs Cuckoo Negative-Lookup Filters\n");
+        printf("14. Benchmark: Bucketized Cuckoo Load and Lookup Latency\n0. Exit\n");
+        printf("Enter Choice: ");
+        
+        if (scanf("%d", &choice) != 1) break;
+
+        switch (choice) {
+            case 1:
+                printf("Enter Key (int): ");
+                scanf("%d", &key);
+                printf("Enter Value (int): ");
+                scanf("%d", &val);
+                insert(ht, key, val);
+                break;
+            case 2:
+                printf("Enter Key to Search: ");
+                scanf("%d", &key);
+                result = search(ht, key);
+                if (result != -1) printf("Found! Value: %d\n", result);
+                else printf("Key not found.\n");
+                break;
+            case 3:
+                printf("Enter Key to Delete: ");
+                scanf("%d", &key);
+                deleteKey(ht, key);
+                break;
+            case 4:
+                display(ht);
+                break;
+            case 5:
+                benchmarkFlatVsChained(1000000);
+                break;
+            case 6:
+                benchmarkRehashLatency(2000000);
+                break;
+            case 7:
+                benchmarkConcurrent(32);
+                break;
+            case 8:
+                benchmarkRobinHoodChurn(100000000LL);
+                break;
+            case 9:
+                benchmarkHashFunctions();
+                break;
+            case 10:
+                if (persistentWrite(ht, SNAPSHOT_FILE)) printf("Saved %d keys to %s.\n", ht->size, SNAPSHOT_FILE);
+                else printf("Could not write %s.\n", SNAPSHOT_FILE);
+                break;
+            case 11: {
+                struct PersistentTable* pt = persistentOpen(SNAPSHOT_FILE);
+                if (pt == NULL) { printf("No valid snapshot in %s.\n", SNAPSHOT_FILE); break; }
+                printf("Enter Key to Search: ");
+                scanf("%d", &key);
+                result = persistentSearch(pt, key);
+                if (result != -1) printf("Found! Value: %d\n", result);
+                else printf("Key not found.\n");
+                persistentClose(pt);
+                break;
+            }
+            case 12:
+                benchmarkPersistentStartup(2000000, SNAPSHOT_FILE);
+                break;
+            case 13:
+                benchmarkNegativeLookups(1000000, 0.95, 0.01);
+                break;
+            case 14:
+                benchmarkBucketCuckoo(1 << 22);
+                break;
+            case 0:
                 printf("Exiting...\n");
                 cleanUp(ht);
                 exit(0);
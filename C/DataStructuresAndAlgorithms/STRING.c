@@ -2,10 +2,24 @@
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #define MAX 1000
 #define d 256     /* Number of characters in the input alphabet for Rabin-Karp */
 #define PRIME 101 /* A prime number for Rabin-Karp hashing */
+#define INDEX_FILE "suffix.sax"
+#define SEARCH_BENCH_FILE "search_bench.log"
 
 /* --- Utility Functions --- */
 
@@ -167,58 +181,2711 @@ void rabinKarpSearch(char* txt, char* pat) {
    --------------------------------------------------------- */
 
 /* --- A. Longest Common Subsequence (LCS) --- */
-void longestCommonSubsequence(char* S1, char* S2) {
+/* Returns the length, or -1 if the table cannot be allocated */
+int lcsLengthTable(const char* S1, const char* S2) {
     int m = strlen(S1);
     int n = strlen(S2);
-    int i, j;
+    int i, j, result;
     
     /* Using malloc for 2D array simulation to avoid Stack Overflow and VLA errors */
     /* We map 2D coordinates (r, c) to 1D index: r * (n+1) + c */
     int *L = (int*)malloc(sizeof(int) * (m + 1) * (n + 1));
     
-    if (L == NULL) { printf("Memory allocation failed\n"); return; }
+    if (L == NULL) return -1;
+
+    for (i = 0; i <= m; i++) {
+        for (j = 0; j <= n; j++) {
+            if (i == 0 || j == 0)
+                L[i * (n + 1) + j] = 0;
+            else if (S1[i - 1] == S2[j - 1])
+                L[i * (n + 1) + j] = L[(i - 1) * (n + 1) + (j - 1)] + 1;
+            else
+                L[i * (n + 1) + j] = max_val(L[(i - 1) * (n + 1) + j], L[i * (n + 1) + (j - 1)]);
+        }
+    }
+    result = L[m * (n + 1) + n];
+    free(L);
+    return result;
+}
+
+char* lcsString(const char* a, size_t lenA, const char* b, size_t lenB, size_t* outLen);
+
+/* Linear space: the subsequence itself comes from lcsString (section 8) */
+void longestCommonSubsequence(char* S1, char* S2) {
+    size_t len;
+    char* lcs = lcsString(S1, strlen(S1), S2, strlen(S2), &len);
+    if (lcs == NULL) { printf("Memory allocation failed\n"); return; }
+    printf("Length of LCS is: %lu\n", (unsigned long)len);
+    printf("LCS: \"%s\"\n", lcs);
+    free(lcs);
+}
+
+/* --- B. Edit Distance (Levenshtein) --- */
+/* Returns the distance, or -1 if the table cannot be allocated */
+int editDistanceTable(const char* str1, const char* str2) {
+    int m = strlen(str1);
+    int n = strlen(str2);
+    int i, j, result;
+
+    /* Using malloc for 2D array simulation */
+    int *dp = (int*)malloc(sizeof(int) * (m + 1) * (n + 1));
+    
+    if (dp == NULL) return -1;
+
+    for (i = 0; i <= m; i++) {
+        for (j = 0; j <= n; j++) {
+            if (i == 0)
+                dp[i * (n + 1) + j] = j; 
+            else if (j == 0)
+                dp[i * (n + 1) + j] = i; 
+            else if (str1[i - 1] == str2[j - 1])
+                dp[i * (n + 1) + j] = dp[(i - 1) * (n + 1) + (j - 1)];
+            else
+                dp[i * (n + 1) + j] = 1 + min3_val(dp[i * (n + 1) + (j - 1)],       /* Insert */
+                                                   dp[(i - 1) * (n + 1) + j],       /* Remove */
+                                                   dp[(i - 1) * (n + 1) + (j - 1)]);/* Replace */
+        }
+    }
+    result = dp[m * (n + 1) + n];
+    free(dp);
+    return result;
+}
+
+void editDistance(char* str1, char* str2) {
+    int result = editDistanceTable(str1, str2);
+    if (result < 0) { printf("Memory allocation failed\n"); return; }
+    printf("Minimum Edit Distance: %d\n", result);
+}
+
+/* ---------------------------------------------------------
+   4. SEARCH LIBRARY (All Matches, SIMD Filter, Two-Way)
+   --------------------------------------------------------- */
+
+/* The functions in section 2 print as they go and walk the text one byte
+   at a time. These return every match offset through a callback (or an
+   array) and take explicit lengths, so they work on binary data and on
+   buffers that are not NUL-terminated.
+
+   Algorithm choice (SEARCH_AUTO):
+     m <= SIMD_FILTER_MAX : compare the pattern's first and last byte against
+                            16/32 text positions at once, verify candidates
+                            with memcmp. If too many candidates fail (e.g.
+                            "aaaa" in a run of 'a'), switch to Two-Way.
+     longer patterns      : Two-Way (Crochemore-Perrin), linear time, O(1)
+                            extra space. A failed verify of a very long
+                            pattern costs too much to risk on the filter.
+     no SSE2              : Two-Way for every length.
+   KMP is slower than both on a whole buffer; it is kept for callers that
+   feed text in pieces, since its entire state is one int. */
+
+#if defined(__SSE2__)
+#define SIMD_FILTER_MAX 256
+#else
+#define SIMD_FILTER_MAX 0
+#endif
+#define FILTER_CHECK_INTERVAL 4096 /* Bytes between candidate-quality checks */
+
+/* Return nonzero to stop the search */
+typedef int (*MatchCallback)(size_t offset, void* ctx);
+
+enum SearchAlgo { SEARCH_AUTO, SEARCH_SIMD, SEARCH_KMP, SEARCH_TWO_WAY };
+
+struct SearchPattern {
+    const unsigned char* pat;
+    long m;
+    enum SearchAlgo algo;
+    int* lps;      /* KMP failure table, only for SEARCH_KMP */
+    long ell;      /* Two-Way critical position */
+    long per;      /* Two-Way shift */
+    int periodic;  /* Pattern is periodic with period 'per' */
+};
+
+/* Maximal suffix of x under '<' (rev = 0) or '>' (rev = 1); *p is its period */
+static long maxSuffix(const unsigned char* x, long m, long* p, int rev) {
+    long ms = -1, j = 0, k = 1;
+    unsigned char a, b;
+    *p = 1;
+    while (j + k < m) {
+        a = x[j + k];
+        b = x[ms + k];
+        if (rev ? (a > b) : (a < b)) {
+            j += k;
+            k = 1;
+            *p = j - ms;
+        } else if (a == b) {
+            if (k != *p) k++;
+            else { j += *p; k = 1; }
+        } else {
+            ms = j;
+            j = ms + 1;
+            k = *p = 1;
+        }
+    }
+    return ms;
+}
+
+static void twoWayFactorize(struct SearchPattern* sp) {
+    long p, q;
+    long i = maxSuffix(sp->pat, sp->m, &p, 0);
+    long j = maxSuffix(sp->pat, sp->m, &q, 1);
+    if (i > j) { sp->ell = i; sp->per = p; }
+    else { sp->ell = j; sp->per = q; }
+
+    sp->periodic = (sp->per + sp->ell + 1 <= sp->m && memcmp(sp->pat, sp->pat + sp->per, sp->ell + 1) == 0);
+    if (!sp->periodic)
+        sp->per = ((sp->ell + 1 > sp->m - sp->ell - 1) ? sp->ell + 1 : sp->m - sp->ell - 1) + 1;
+}
+
+/* Returns 0 on failure. 'pat' must outlive the compiled pattern. */
+int compileSearchPattern(struct SearchPattern* sp, const char* pat, size_t m, enum SearchAlgo algo) {
+    sp->pat = (const unsigned char*)pat;
+    sp->m = (long)m;
+    sp->lps = NULL;
+    sp->algo = algo;
+    if (algo == SEARCH_AUTO) sp->algo = (m <= SIMD_FILTER_MAX) ? SEARCH_SIMD : SEARCH_TWO_WAY;
+    if (m == 0) return 1;
+
+    twoWayFactorize(sp); /* Also the SIMD filter's fallback */
+    if (sp->algo == SEARCH_KMP) {
+        sp->lps = (int*)malloc(sizeof(int) * m);
+        if (sp->lps == NULL) return 0;
+        computeLPSArray((char*)pat, (int)m, sp->lps);
+    }
+    return 1;
+}
+
+void freeSearchPattern(struct SearchPattern* sp) {
+    free(sp->lps);
+    sp->lps = NULL;
+}
+
+/* --- Two-Way scan of txt[from, n) --- */
+static size_t twoWayScan(const struct SearchPattern* sp, const unsigned char* txt, long n, long from,
+                         MatchCallback cb, void* ctx) {
+    const unsigned char* x = sp->pat;
+    long m = sp->m, ell = sp->ell, per = sp->per;
+    long i, j = from, memory = -1;
+    size_t count = 0;
+
+    if (sp->periodic) {
+        while (j <= n - m) {
+            i = (ell > memory ? ell : memory) + 1;
+            while (i < m && x[i] == txt[i + j]) i++;
+            if (i >= m) {
+                i = ell;
+                while (i > memory && x[i] == txt[i + j]) i--;
+                if (i <= memory) {
+                    count++;
+                    if (cb && cb((size_t)j, ctx)) return count;
+                }
+                j += per;
+                memory = m - per - 1;
+            } else {
+                j += i - ell;
+                memory = -1;
+            }
+        }
+    } else {
+        while (j <= n - m) {
+            i = ell + 1;
+            while (i < m && x[i] == txt[i + j]) i++;
+            if (i >= m) {
+                i = ell;
+                while (i >= 0 && x[i] == txt[i + j]) i--;
+                if (i < 0) {
+                    count++;
+                    if (cb && cb((size_t)j, ctx)) return count;
+                }
+                j += per;
+            } else {
+                j += i - ell;
+            }
+        }
+    }
+    return count;
+}
+
+/* --- KMP scan with a precomputed table --- */
+static size_t kmpScan(const struct SearchPattern* sp, const unsigned char* txt, long n,
+                      MatchCallback cb, void* ctx) {
+    long i;
+    int j = 0;
+    size_t count = 0;
+    for (i = 0; i < n; i++) {
+        while (j > 0 && sp->pat[j] != txt[i]) j = sp->lps[j - 1];
+        if (sp->pat[j] == txt[i]) j++;
+        if (j == sp->m) {
+            count++;
+            if (cb && cb((size_t)(i - sp->m + 1), ctx)) return count;
+            j = sp->lps[j - 1];
+        }
+    }
+    return count;
+}
+
+/* --- SIMD first/last-byte filter --- */
+#if defined(__AVX2__)
+#define FILTER_BLOCK 32
+#else
+#define FILTER_BLOCK 16
+#endif
+
+/* Bit k set if txt[i + k] == first and txt[i + k + m - 1] == last */
+static unsigned int filterBlock(const unsigned char* txt, long i, long m, unsigned char first, unsigned char last) {
+#if defined(__AVX2__)
+    __m256i a = _mm256_loadu_si256((const __m256i*)(txt + i));
+    __m256i b = _mm256_loadu_si256((const __m256i*)(txt + i + m - 1));
+    __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, _mm256_set1_epi8((char)first)),
+                                  _mm256_cmpeq_epi8(b, _mm256_set1_epi8((char)last)));
+    return (unsigned int)_mm256_movemask_epi8(eq);
+#elif defined(__SSE2__)
+    __m128i a = _mm_loadu_si128((const __m128i*)(txt + i));
+    __m128i b = _mm_loadu_si128((const __m128i*)(txt + i + m - 1));
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a, _mm_set1_epi8((char)first)),
+                               _mm_cmpeq_epi8(b, _mm_set1_epi8((char)last)));
+    return (unsigned int)_mm_movemask_epi8(eq);
+#else
+    unsigned int mask = 0;
+    int k;
+    for (k = 0; k < FILTER_BLOCK; k++)
+        if (txt[i + k] == first && txt[i + k + m - 1] == last) mask |= 1u << k;
+    return mask;
+#endif
+}
+
+static size_t simdFilterScan(const struct SearchPattern* sp, const unsigned char* txt, long n,
+                             MatchCallback cb, void* ctx) {
+    const unsigned char* x = sp->pat;
+    long m = sp->m;
+    unsigned char first = x[0], last = x[m - 1];
+    long i = 0, k, checkpoint = FILTER_CHECK_INTERVAL;
+    long falseHits = 0;
+    size_t count = 0;
+    unsigned int mask;
+
+    for (; i + m - 1 + FILTER_BLOCK <= n; i += FILTER_BLOCK) {
+        mask = filterBlock(txt, i, m, first, last);
+        while (mask) {
+            k = i + __builtin_ctz(mask);
+            if (m <= 2 || memcmp(txt + k + 1, x + 1, m - 2) == 0) {
+                count++;
+                if (cb && cb((size_t)k, ctx)) return count;
+            } else {
+                falseHits++;
+            }
+            mask &= mask - 1;
+        }
+        /* More than one failed verify per 16 bytes: the filter is not
+           discriminating here, Two-Way is faster from now on */
+        if (i >= checkpoint) {
+            if (falseHits * 16 > checkpoint)
+                return count + twoWayScan(sp, txt, n, i + FILTER_BLOCK, cb, ctx);
+            checkpoint += FILTER_CHECK_INTERVAL;
+        }
+    }
+    for (; i <= n - m; i++) {
+        if (txt[i] == first && memcmp(txt + i, x, m) == 0) {
+            count++;
+            if (cb && cb((size_t)i, ctx)) return count;
+        }
+    }
+    return count;
+}
+
+/* Calls cb(offset, ctx) for every match in txt[0, n) in increasing order,
+   overlapping matches included. Returns the number of matches reported. */
+size_t searchCompiled(const struct SearchPattern* sp, const char* txt, size_t n, MatchCallback cb, void* ctx) {
+    const unsigned char* t = (const unsigned char*)txt;
+    if (sp->m == 0 || (long)n < sp->m) return 0;
+    switch (sp->algo) {
+    case SEARCH_KMP:
+        return kmpScan(sp, t, (long)n, cb, ctx);
+    case SEARCH_TWO_WAY:
+        return twoWayScan(sp, t, (long)n, 0, cb, ctx);
+    default:
+        return simdFilterScan(sp, t, (long)n, cb, ctx);
+    }
+}
+
+size_t searchAll(const char* txt, size_t n, const char* pat, size_t m, MatchCallback cb, void* ctx) {
+    struct SearchPattern sp;
+    size_t count;
+    if (!compileSearchPattern(&sp, pat, m, SEARCH_AUTO)) return 0;
+    count = searchCompiled(&sp, txt, n, cb, ctx);
+    freeSearchPattern(&sp);
+    return count;
+}
+
+/* Growable offset array for searchAllOffsets */
+struct OffsetList {
+    size_t* items;
+    size_t count;
+    size_t cap;
+};
+
+static int collectOffset(size_t offset, void* ctx) {
+    struct OffsetList* list = (struct OffsetList*)ctx;
+    if (list->count == list->cap) {
+        size_t newCap = list->cap ? list->cap * 2 : 16;
+        size_t* grown = (size_t*)realloc(list->items, sizeof(size_t) * newCap);
+        if (grown == NULL) return 1; /* Stop: keep what we have */
+        list->items = grown;
+        list->cap = newCap;
+    }
+    list->items[list->count++] = offset;
+    return 0;
+}
+
+/* Returns a malloc'd array of all match offsets (caller frees), *count set */
+size_t* searchAllOffsets(const char* txt, size_t n, const char* pat, size_t m, size_t* count) {
+    struct OffsetList list = { NULL, 0, 0 };
+    searchAll(txt, n, pat, m, collectOffset, &list);
+    *count = list.count;
+    return list.items;
+}
+
+/* --- Throughput benchmark --- */
+
+static double wallSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int countMatch(size_t offset, void* ctx) {
+    (void)offset;
+    (*(size_t*)ctx)++;
+    return 0;
+}
+
+/* Synthetic access log: mostly fixed words with varying numbers */
+static char* makeLogText(size_t n) {
+    static const char* levels[] = { "INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR" };
+    static const char* paths[] = { "/api/users", "/api/orders", "/health", "/static/app.js", "/login" };
+    char* txt = (char*)malloc(n + 1);
+    char line[160];
+    size_t pos = 0;
+    unsigned int seed = 12345;
+    int len;
+    if (txt == NULL) return NULL;
+    while (pos < n) {
+        seed = seed * 1103515245u + 12345u;
+        len = sprintf(line, "2024-05-%02u 12:%02u:%02u %s worker-%u GET %s status=%u latency=%ums\n",
+                      1 + (seed >> 8) % 28, (seed >> 12) % 60, (seed >> 16) % 60,
+                      levels[(seed >> 20) % 6], (seed >> 4) % 64, paths[(seed >> 24) % 5],
+                      ((seed >> 9) % 50 == 0) ? 503u : 200u, (seed >> 3) % 900);
+        if (pos + len > n) len = (int)(n - pos);
+        memcpy(txt + pos, line, len);
+        pos += len;
+    }
+    txt[n] = '\0';
+    return txt;
+}
+
+static void benchmarkOne(const char* label, const char* txt, size_t n, const char* pat) {
+    static const char* names[] = { "auto", "simd", "kmp", "two-way" };
+    struct SearchPattern sp;
+    size_t m = strlen(pat), count, naive = 0, i;
+    double start, secs;
+    int algo;
+
+    /* Scalar baseline: the naiveSearch loop without printing */
+    start = wallSeconds();
+    for (i = 0; i + m <= n; i++)
+        if (txt[i] == pat[0] && memcmp(txt + i, pat, m) == 0) naive++;
+    secs = wallSeconds() - start;
+    printf("%-12s m=%-4lu %-8s %8.2f GB/s %10lu matches\n", label, (unsigned long)m, "naive",
+           n / secs / 1e9, (unsigned long)naive);
+
+    for (algo = SEARCH_SIMD; algo <= SEARCH_TWO_WAY; algo++) {
+        count = 0;
+        compileSearchPattern(&sp, pat, m, (enum SearchAlgo)algo);
+        start = wallSeconds();
+        searchCompiled(&sp, txt, n, countMatch, &count);
+        secs = wallSeconds() - start;
+        freeSearchPattern(&sp);
+        printf("%-12s m=%-4lu %-8s %8.2f GB/s %10lu matches%s\n", "", (unsigned long)m, names[algo],
+               n / secs / 1e9, (unsigned long)count, count == naive ? "" : "  MISMATCH");
+    }
+}
+
+void benchmarkSearch(size_t n) {
+    char* txt = makeLogText(n);
+    char* runs;
+    char periodicPat[41];
+    if (txt == NULL) { printf("Memory allocation failed\n"); return; }
+
+    printf("\n--- Search Throughput (%lu MB synthetic log) ---\n", (unsigned long)(n >> 20));
+    benchmarkOne("byte", txt, n, "E");
+    benchmarkOne("word", txt, n, "ERROR");
+    benchmarkOne("field", txt, n, "status=503 latency=1");
+    benchmarkOne("long", txt, n, "GET /api/orders status=200 latency=5ms\n2024-05-07 12:00:00 ERROR worker-1");
+    free(txt);
+
+    /* Worst case for a first/last filter: almost every position is a candidate */
+    runs = (char*)malloc(n + 1);
+    if (runs == NULL) return;
+    memset(runs, 'a', n);
+    runs[n] = '\0';
+    memset(periodicPat, 'a', 40);
+    periodicPat[19] = 'b';
+    periodicPat[40] = '\0';
+    benchmarkOne("a..ab..a", runs, n / 8, periodicPat);
+    free(runs);
+}
+
+/* ---------------------------------------------------------
+   5. MULTI-PATTERN SEARCH (Aho-Corasick)
+   --------------------------------------------------------- */
+
+/* One pass over the text finds every occurrence of every keyword.
+   Layout of the automaton, built once:
+     - Byte classes: bytes that occur in no pattern behave identically and
+       share class 0; each byte that does occur gets its own class. Tables
+       are indexed by class, so 10,000 lowercase keywords need ~30 columns
+       instead of 256.
+     - States are numbered in BFS order. The first 'denseStates' (the shallow
+       ones, where the scan spends nearly all its time) get a full DFA row:
+       one load per byte, no failure links.
+     - Deeper states keep only their real edges (sparse) plus a failure link;
+       a miss follows failure links until it reaches a dense state.
+   Transitions into a state that has output carry AC_MATCH_BIT, so the scan
+   loop tests the value it just loaded instead of a second table.
+   Matches are reported as (start offset, pattern id). */
+
+#ifndef AC_DENSE_BUDGET
+#define AC_DENSE_BUDGET (1 << 22) /* Bytes allowed for the dense table */
+#endif
+#define AC_MATCH_BIT 0x40000000   /* Set on transitions into states with output */
+
+struct AhoCorasick {
+    int numPatterns;
+    int* patLen;
+    int maxLen;
+
+    unsigned short classOf[256];
+    int numClasses;
+
+    int numStates;
+    int denseStates;
+    int* dense;          /* denseStates * numClasses transitions (with AC_MATCH_BIT) */
+    int* sparseStart;    /* Per sparse state: edges [start[i], start[i + 1]) */
+    unsigned short* edgeClass;
+    int* edgeNext;       /* With AC_MATCH_BIT */
+    int* fail;
+
+    int* reportFrom;     /* First state on the suffix chain with output, -1 if none */
+    int* dictLink;       /* Next state with output along the failure chain */
+    int* outHead;        /* First pattern id ending exactly at the state */
+    int* outNext;        /* Next pattern id with the same string */
+};
+
+/* Return nonzero to stop */
+typedef int (*AcMatchCallback)(size_t offset, int patternId, void* ctx);
+
+/* Trie used only while building: edges as singly linked lists */
+struct AcBuilder {
+    int* firstEdge;
+    int* edgeTo;
+    int* edgeLink;
+    unsigned short* edgeCls;
+    int numNodes, nodeCap, numEdges, edgeCap;
+};
+
+static int acBuilderChild(struct AcBuilder* b, int node, unsigned short cls) {
+    int e;
+    for (e = b->firstEdge[node]; e >= 0; e = b->edgeLink[e])
+        if (b->edgeCls[e] == cls) return b->edgeTo[e];
+    return -1;
+}
+
+static int acBuilderAdd(struct AcBuilder* b, int node, unsigned short cls) {
+    int child = b->numNodes++;
+    if (b->numNodes > b->nodeCap) {
+        b->nodeCap *= 2;
+        b->firstEdge = (int*)realloc(b->firstEdge, sizeof(int) * b->nodeCap);
+    }
+    b->firstEdge[child] = -1;
+    if (b->numEdges == b->edgeCap) {
+        b->edgeCap *= 2;
+        b->edgeTo = (int*)realloc(b->edgeTo, sizeof(int) * b->edgeCap);
+        b->edgeLink = (int*)realloc(b->edgeLink, sizeof(int) * b->edgeCap);
+        b->edgeCls = (unsigned short*)realloc(b->edgeCls, sizeof(unsigned short) * b->edgeCap);
+    }
+    b->edgeTo[b->numEdges] = child;
+    b->edgeCls[b->numEdges] = cls;
+    b->edgeLink[b->numEdges] = b->firstEdge[node];
+    b->firstEdge[node] = b->numEdges++;
+    return child;
+}
+
+/* 's' must not carry AC_MATCH_BIT; the result may */
+static int acNext(const struct AhoCorasick* ac, int s, unsigned char byte) {
+    int c = ac->classOf[byte];
+    int k, end;
+    while (s >= ac->denseStates) {
+        end = ac->sparseStart[s - ac->denseStates + 1];
+        for (k = ac->sparseStart[s - ac->denseStates]; k < end; k++)
+            if (ac->edgeClass[k] == c) return ac->edgeNext[k];
+        s = ac->fail[s];
+    }
+    return ac->dense[(size_t)s * ac->numClasses + c];
+}
+
+/* Builds the automaton for patterns[0..count). Empty patterns are ignored.
+   Returns NULL on allocation failure. */
+struct AhoCorasick* acBuild(const char* const* patterns, int count) {
+    struct AhoCorasick* ac;
+    struct AcBuilder b;
+    int *order, *newId, *nodeOut, *nodeFail, *endNode;
+    int i, j, node, child, head, tail, s, e, c, f, k;
+    unsigned char used[256];
+
+    ac = (struct AhoCorasick*)calloc(1, sizeof(struct AhoCorasick));
+    if (ac == NULL) return NULL;
+    ac->numPatterns = count;
+    ac->patLen = (int*)malloc(sizeof(int) * (count ? count : 1));
+    ac->outNext = (int*)malloc(sizeof(int) * (count ? count : 1));
+
+    /* 1. Byte classes */
+    memset(used, 0, sizeof(used));
+    for (i = 0; i < count; i++) {
+        ac->patLen[i] = (int)strlen(patterns[i]);
+        if (ac->patLen[i] > ac->maxLen) ac->maxLen = ac->patLen[i];
+        for (j = 0; j < ac->patLen[i]; j++) used[(unsigned char)patterns[i][j]] = 1;
+    }
+    ac->numClasses = 1;
+    for (i = 0; i < 256; i++) ac->classOf[i] = used[i] ? (unsigned short)ac->numClasses++ : 0;
+
+    /* 2. Trie */
+    b.nodeCap = 1024;
+    b.edgeCap = 1024;
+    b.firstEdge = (int*)malloc(sizeof(int) * b.nodeCap);
+    b.edgeTo = (int*)malloc(sizeof(int) * b.edgeCap);
+    b.edgeLink = (int*)malloc(sizeof(int) * b.edgeCap);
+    b.edgeCls = (unsigned short*)malloc(sizeof(unsigned short) * b.edgeCap);
+    b.numNodes = 1;
+    b.numEdges = 0;
+    b.firstEdge[0] = -1;
+
+    endNode = (int*)malloc(sizeof(int) * (count ? count : 1));
+    for (i = 0; i < count; i++) {
+        node = 0;
+        for (j = 0; j < ac->patLen[i]; j++) {
+            c = ac->classOf[(unsigned char)patterns[i][j]];
+            child = acBuilderChild(&b, node, (unsigned short)c);
+            node = (child >= 0) ? child : acBuilderAdd(&b, node, (unsigned short)c);
+        }
+        endNode[i] = node;
+    }
+
+    /* Output lists per trie node; duplicates chain through outNext */
+    nodeOut = (int*)malloc(sizeof(int) * b.numNodes);
+    for (i = 0; i < b.numNodes; i++) nodeOut[i] = -1;
+    for (i = count - 1; i >= 0; i--) {
+        ac->outNext[i] = -1;
+        if (ac->patLen[i] == 0) continue;
+        ac->outNext[i] = nodeOut[endNode[i]];
+        nodeOut[endNode[i]] = i;
+    }
+    free(endNode);
+
+    /* 3. BFS order and failure links (in trie ids) */
+    order = (int*)malloc(sizeof(int) * b.numNodes);
+    newId = (int*)malloc(sizeof(int) * b.numNodes);
+    nodeFail = (int*)malloc(sizeof(int) * b.numNodes);
+    head = 0;
+    tail = 0;
+    order[tail++] = 0;
+    nodeFail[0] = 0;
+    while (head < tail) {
+        node = order[head++];
+        for (e = b.firstEdge[node]; e >= 0; e = b.edgeLink[e]) {
+            child = b.edgeTo[e];
+            order[tail++] = child;
+            if (node == 0) {
+                nodeFail[child] = 0;
+            } else {
+                f = nodeFail[node];
+                while (f != 0 && acBuilderChild(&b, f, b.edgeCls[e]) < 0) f = nodeFail[f];
+                s = acBuilderChild(&b, f, b.edgeCls[e]);
+                nodeFail[child] = (s >= 0) ? s : 0;
+            }
+        }
+    }
+    for (i = 0; i < b.numNodes; i++) newId[order[i]] = i;
+
+    /* 4. Final tables in BFS numbering */
+    ac->numStates = b.numNodes;
+    ac->denseStates = AC_DENSE_BUDGET / (int)(sizeof(int) * ac->numClasses);
+    if (ac->denseStates < 1) ac->denseStates = 1;
+    if (ac->denseStates > ac->numStates) ac->denseStates = ac->numStates;
+
+    ac->fail = (int*)malloc(sizeof(int) * ac->numStates);
+    ac->outHead = (int*)malloc(sizeof(int) * ac->numStates);
+    ac->reportFrom = (int*)malloc(sizeof(int) * ac->numStates);
+    ac->dictLink = (int*)malloc(sizeof(int) * ac->numStates);
+    ac->dense = (int*)malloc(sizeof(int) * (size_t)ac->denseStates * ac->numClasses);
+    ac->sparseStart = (int*)malloc(sizeof(int) * (ac->numStates - ac->denseStates + 1));
+    ac->edgeClass = (unsigned short*)malloc(sizeof(unsigned short) * (b.numEdges ? b.numEdges : 1));
+    ac->edgeNext = (int*)malloc(sizeof(int) * (b.numEdges ? b.numEdges : 1));
+
+    k = 0;
+    for (s = 0; s < ac->numStates; s++) {
+        node = order[s];
+        ac->fail[s] = newId[nodeFail[node]];
+        ac->outHead[s] = nodeOut[node];
+        /* Failure targets are shallower, so already final */
+        ac->dictLink[s] = (s == 0) ? -1 : ac->reportFrom[ac->fail[s]];
+        ac->reportFrom[s] = (ac->outHead[s] >= 0) ? s : ac->dictLink[s];
+
+        if (s < ac->denseStates) {
+            int* row = ac->dense + (size_t)s * ac->numClasses;
+            if (s == 0) {
+                for (c = 0; c < ac->numClasses; c++) row[c] = 0;
+            } else {
+                memcpy(row, ac->dense + (size_t)ac->fail[s] * ac->numClasses, sizeof(int) * ac->numClasses);
+            }
+            for (e = b.firstEdge[node]; e >= 0; e = b.edgeLink[e]) row[b.edgeCls[e]] = newId[b.edgeTo[e]];
+        } else {
+            ac->sparseStart[s - ac->denseStates] = k;
+            for (e = b.firstEdge[node]; e >= 0; e = b.edgeLink[e]) {
+                ac->edgeClass[k] = b.edgeCls[e];
+                ac->edgeNext[k] = newId[b.edgeTo[e]];
+                k++;
+            }
+        }
+    }
+    ac->sparseStart[ac->numStates - ac->denseStates] = k;
+
+    /* Tag transitions into states with output */
+    for (i = 0; i < ac->denseStates * ac->numClasses; i++)
+        if (ac->reportFrom[ac->dense[i]] >= 0) ac->dense[i] |= AC_MATCH_BIT;
+    for (i = 0; i < k; i++)
+        if (ac->reportFrom[ac->edgeNext[i]] >= 0) ac->edgeNext[i] |= AC_MATCH_BIT;
+
+    free(order);
+    free(newId);
+    free(nodeOut);
+    free(nodeFail);
+    free(b.firstEdge);
+    free(b.edgeTo);
+    free(b.edgeLink);
+    free(b.edgeCls);
+    return ac;
+}
+
+void acFree(struct AhoCorasick* ac) {
+    if (ac == NULL) return;
+    free(ac->patLen);
+    free(ac->outNext);
+    free(ac->dense);
+    free(ac->sparseStart);
+    free(ac->edgeClass);
+    free(ac->edgeNext);
+    free(ac->fail);
+    free(ac->reportFrom);
+    free(ac->dictLink);
+    free(ac->outHead);
+    free(ac);
+}
+
+/* Reports every pattern ending at 'end' (absolute offset of the last byte).
+   Only matches starting at or after 'minStart' are reported. */
+static int acReport(const struct AhoCorasick* ac, int s, size_t end, size_t minStart,
+                    AcMatchCallback cb, void* ctx, size_t* count) {
+    int t, pid;
+    size_t start;
+    for (t = ac->reportFrom[s]; t >= 0; t = ac->dictLink[t]) {
+        for (pid = ac->outHead[t]; pid >= 0; pid = ac->outNext[pid]) {
+            start = end + 1 - ac->patLen[pid];
+            if (start < minStart) continue;
+            (*count)++;
+            if (cb && cb(start, pid, ctx)) return 1;
+        }
+    }
+    return 0;
+}
+
+/* Streaming matcher: feed buffers in order, matches that straddle two
+   buffers are still found and reported with absolute offsets. */
+struct AcStream {
+    const struct AhoCorasick* ac;
+    int state;
+    size_t consumed;  /* Bytes fed so far */
+};
+
+void acStreamInit(struct AcStream* st, const struct AhoCorasick* ac) {
+    st->ac = ac;
+    st->state = 0;
+    st->consumed = 0;
+}
+
+/* Returns the number of matches reported from this buffer */
+size_t acStreamFeed(struct AcStream* st, const char* buf, size_t len, AcMatchCallback cb, void* ctx) {
+    const struct AhoCorasick* ac = st->ac;
+    const unsigned char* p = (const unsigned char*)buf;
+    size_t i, count = 0;
+    int s = st->state;
+    for (i = 0; i < len; i++) {
+        s = acNext(ac, s, p[i]);
+        if (s & AC_MATCH_BIT) {
+            s &= ~AC_MATCH_BIT;
+            if (acReport(ac, s, st->consumed + i, 0, cb, ctx, &count)) {
+                i++;
+                break;
+            }
+        }
+    }
+    st->state = s;
+    st->consumed += i;
+    return count;
+}
+
+size_t acSearch(const struct AhoCorasick* ac, const char* txt, size_t n, AcMatchCallback cb, void* ctx) {
+    struct AcStream st;
+    acStreamInit(&st, ac);
+    return acStreamFeed(&st, txt, n, cb, ctx);
+}
+
+/* --- Multithreaded scan of independent chunks ---
+   Thread k owns the matches that START in [begin_k, end_k). It runs the
+   automaton from the root at begin_k and keeps going up to maxLen - 1 bytes
+   past end_k, so a match crossing the boundary is found exactly once. */
+
+struct AcMatch {
+    size_t offset;
+    int patternId;
+};
+
+struct AcChunkJob {
+    const struct AhoCorasick* ac;
+    const unsigned char* txt;
+    size_t begin, end, n;
+    struct AcMatch* matches;
+    size_t count, cap;
+    int failed;
+};
+
+static int acCollect(size_t offset, int patternId, void* ctx) {
+    struct AcChunkJob* job = (struct AcChunkJob*)ctx;
+    if (offset >= job->end) return 0;
+    if (job->count == job->cap) {
+        size_t newCap = job->cap ? job->cap * 2 : 256;
+        struct AcMatch* grown = (struct AcMatch*)realloc(job->matches, sizeof(struct AcMatch) * newCap);
+        if (grown == NULL) { job->failed = 1; return 1; }
+        job->matches = grown;
+        job->cap = newCap;
+    }
+    job->matches[job->count].offset = offset;
+    job->matches[job->count].patternId = patternId;
+    job->count++;
+    return 0;
+}
+
+static void* acChunkWorker(void* arg) {
+    struct AcChunkJob* job = (struct AcChunkJob*)arg;
+    const struct AhoCorasick* ac = job->ac;
+    size_t stop = job->end + (ac->maxLen > 0 ? ac->maxLen - 1 : 0);
+    size_t i, unused = 0;
+    int s = 0;
+    if (stop > job->n) stop = job->n;
+    for (i = job->begin; i < stop; i++) {
+        s = acNext(ac, s, job->txt[i]);
+        if (s & AC_MATCH_BIT) {
+            s &= ~AC_MATCH_BIT;
+            if (acReport(ac, s, i, job->begin, acCollect, job, &unused)) break;
+        }
+    }
+    return NULL;
+}
+
+/* Scans txt with 'threads' workers. *out receives a malloc'd array of the
+   matches (caller frees), ordered by chunk and, within a chunk, by end
+   offset. Returns the number of matches, or (size_t)-1 on failure. */
+size_t acSearchParallel(const struct AhoCorasick* ac, const char* txt, size_t n, int threads, struct AcMatch** out) {
+    pthread_t* tids;
+    struct AcChunkJob* jobs;
+    size_t chunk, total = 0;
+    int t, failed = 0;
+    struct AcMatch* all;
+
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > n / 4096 + 1) threads = (int)(n / 4096 + 1);
+    tids = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+    jobs = (struct AcChunkJob*)calloc(threads, sizeof(struct AcChunkJob));
+    chunk = (n + threads - 1) / threads;
+
+    for (t = 0; t < threads; t++) {
+        jobs[t].ac = ac;
+        jobs[t].txt = (const unsigned char*)txt;
+        jobs[t].n = n;
+        jobs[t].begin = (size_t)t * chunk < n ? (size_t)t * chunk : n;
+        jobs[t].end = jobs[t].begin + chunk < n ? jobs[t].begin + chunk : n;
+        pthread_create(&tids[t], NULL, acChunkWorker, &jobs[t]);
+    }
+    for (t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        total += jobs[t].count;
+        failed |= jobs[t].failed;
+    }
+
+    all = failed ? NULL : (struct AcMatch*)malloc(sizeof(struct AcMatch) * (total ? total : 1));
+    total = 0;
+    for (t = 0; t < threads; t++) {
+        if (all != NULL && jobs[t].count) memcpy(all + total, jobs[t].matches, sizeof(struct AcMatch) * jobs[t].count);
+        total += jobs[t].count;
+        free(jobs[t].matches);
+    }
+    free(tids);
+    free(jobs);
+    *out = all;
+    return all ? total : (size_t)-1;
+}
+
+/* --- Keyword benchmark --- */
+
+static int countAcMatch(size_t offset, int patternId, void* ctx) {
+    (void)offset;
+    (void)patternId;
+    (*(size_t*)ctx)++;
+    return 0;
+}
+
+void benchmarkAhoCorasick(size_t n, int numKeywords) {
+    static const char* real[] = { "ERROR", "status=503", "/login", "worker-7 ", "latency=1ms", "12:00:00" };
+    int numReal = (int)(sizeof(real) / sizeof(real[0]));
+    char** words = (char**)malloc(sizeof(char*) * numKeywords);
+    char* txt = makeLogText(n);
+    struct AhoCorasick* ac;
+    struct AcStream st;
+    struct AcMatch* matches;
+    size_t seq = 0, streamed = 0, par, pos, len, realCount, k;
+    unsigned int seed = 99;
+    double start, secs;
+    int i, j, threads, bad = 0;
+
+    if (words == NULL || txt == NULL) { printf("Memory allocation failed\n"); return; }
+    for (i = 0; i < numKeywords; i++) {
+        if (i < numReal) {
+            words[i] = (char*)malloc(strlen(real[i]) + 1);
+            strcpy(words[i], real[i]);
+            continue;
+        }
+        seed = seed * 1103515245u + 12345u;
+        len = 5 + (seed >> 16) % 8;
+        words[i] = (char*)malloc(len + 1);
+        for (j = 0; j < (int)len; j++) {
+            seed = seed * 1103515245u + 12345u;
+            words[i][j] = (char)('a' + (seed >> 16) % 26);
+        }
+        words[i][len] = '\0';
+    }
+
+    start = wallSeconds();
+    ac = acBuild((const char* const*)words, numKeywords);
+    secs = wallSeconds() - start;
+    printf("\n--- Aho-Corasick (%d keywords, %lu MB log) ---\n", numKeywords, (unsigned long)(n >> 20));
+    printf("Build: %.1f ms, %d states (%d dense), %d byte classes, dense table %lu KB\n",
+           secs * 1e3, ac->numStates, ac->denseStates, ac->numClasses,
+           (unsigned long)((size_t)ac->denseStates * ac->numClasses * sizeof(int) >> 10));
+
+    start = wallSeconds();
+    acSearch(ac, txt, n, countAcMatch, &seq);
+    secs = wallSeconds() - start;
+    printf("%-22s %8.2f GB/s %10lu matches\n", "single pass", n / secs / 1e9, (unsigned long)seq);
+
+    /* Stream in 64 KB pieces: boundary-straddling matches must not be lost */
+    acStreamInit(&st, ac);
+    for (pos = 0; pos < n; pos += 65536)
+        acStreamFeed(&st, txt + pos, (n - pos < 65536) ? n - pos : 65536, countAcMatch, &streamed);
+    printf("%-22s %19s %10lu matches%s\n", "streamed, 64 KB feeds", "", (unsigned long)streamed,
+           streamed == seq ? "" : "  MISMATCH");
+
+    for (threads = 1; threads <= 8; threads *= 2) {
+        start = wallSeconds();
+        par = acSearchParallel(ac, txt, n, threads, &matches);
+        secs = wallSeconds() - start;
+        printf("%2d thread(s)           %8.2f GB/s %10lu matches%s\n", threads, n / secs / 1e9,
+               (unsigned long)par, par == seq ? "" : "  MISMATCH");
+        /* Cross-check the known keywords against the single-pattern search */
+        if (threads == 8) {
+            for (i = 0; i < numReal; i++) {
+                realCount = 0;
+                for (k = 0; k < par; k++) if (matches[k].patternId == i) realCount++;
+                if (realCount != searchAll(txt, n, words[i], strlen(words[i]), NULL, NULL)) bad++;
+            }
+            printf("Per-keyword counts vs searchAll(): %s\n", bad ? "MISMATCH" : "ok");
+        }
+        free(matches);
+    }
+
+    acFree(ac);
+    for (i = 0; i < numKeywords; i++) free(words[i]);
+    free(words);
+    free(txt);
+}
+
+/* ---------------------------------------------------------
+   6. SUFFIX ARRAY INDEX (SA-IS + Kasai LCP)
+   --------------------------------------------------------- */
+
+/* Build once, then answer "where does P occur?" in O(m log n) without
+   rescanning the text. sa[] lists suffix start positions in sorted order,
+   so all occurrences of P are one contiguous range of sa[].
+   lcp[i] = length of the common prefix of suffixes sa[i - 1] and sa[i].
+   Indices are 32-bit (texts below 2 GB); build with -DSA_LARGE_TEXT for
+   64-bit indices at twice the memory. */
+
+#ifdef SA_LARGE_TEXT
+typedef long long SaIndex;
+#else
+typedef int SaIndex;
+#endif
+
+#define SA_MAGIC "SAX1"
+
+struct SuffixIndex {
+    unsigned char* text;  /* Owned copy */
+    SaIndex n;
+    SaIndex* sa;
+    SaIndex* lcp;
+};
+
+/* Suffixes of a tiny string by direct comparison (recursion base case) */
+static void saNaive(const SaIndex* s, SaIndex n, SaIndex* sa) {
+    SaIndex i, j, k, a, b;
+    for (i = 0; i < n; i++) sa[i] = i;
+    for (i = 1; i < n; i++) {          /* Insertion sort, n < 10 */
+        for (j = i; j > 0; j--) {
+            a = sa[j - 1];
+            b = sa[j];
+            for (k = 0; a + k < n && b + k < n && s[a + k] == s[b + k]; k++) {}
+            if (a + k == n || (b + k < n && s[a + k] < s[b + k])) break; /* Already ordered */
+            sa[j - 1] = b;
+            sa[j] = a;
+        }
+    }
+}
+
+/* Places LMS suffixes at their bucket ends, then induces L-type suffixes
+   left to right and S-type suffixes right to left. */
+static void saInduce(const SaIndex* s, SaIndex n, SaIndex upper, const unsigned char* isS,
+                     const SaIndex* sumL, const SaIndex* sumS, const SaIndex* lms, SaIndex numLms,
+                     SaIndex* sa, SaIndex* buf) {
+    SaIndex i, v;
+    for (i = 0; i < n; i++) sa[i] = -1;
+
+    memcpy(buf, sumS, sizeof(SaIndex) * (upper + 1));
+    for (i = 0; i < numLms; i++)
+        if (lms[i] != n) sa[buf[s[lms[i]]]++] = lms[i];
+
+    memcpy(buf, sumL, sizeof(SaIndex) * (upper + 1));
+    sa[buf[s[n - 1]]++] = n - 1;
+    for (i = 0; i < n; i++) {
+        v = sa[i];
+        if (v >= 1 && !isS[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+    }
+
+    memcpy(buf, sumL, sizeof(SaIndex) * (upper + 1));
+    for (i = n - 1; i >= 0; i--) {
+        v = sa[i];
+        if (v >= 1 && isS[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+    }
+}
+
+/* SA-IS on an integer string with symbols in [0, upper]. Returns 0 on
+   allocation failure. Recurses on the reduced string of LMS substrings,
+   which is at most half as long. */
+static int saIs(const SaIndex* s, SaIndex n, SaIndex upper, SaIndex* sa) {
+    unsigned char* isS;
+    SaIndex *sumL, *sumS, *buf, *lmsMap, *lms, *sortedLms, *recS, *recSa;
+    SaIndex i, m, recUpper, l, r, endL, endR;
+    int same, ok = 1;
+
+    if (n == 0) return 1;
+    if (n < 10) { saNaive(s, n, sa); return 1; }
+
+    isS = (unsigned char*)malloc(n);
+    sumL = (SaIndex*)calloc(upper + 2, sizeof(SaIndex));
+    sumS = (SaIndex*)calloc(upper + 2, sizeof(SaIndex));
+    buf = (SaIndex*)malloc(sizeof(SaIndex) * (upper + 2));
+    lmsMap = (SaIndex*)malloc(sizeof(SaIndex) * (n + 1));
+    if (!isS || !sumL || !sumS || !buf || !lmsMap) {
+        free(isS); free(sumL); free(sumS); free(buf); free(lmsMap);
+        return 0;
+    }
+
+    /* 1. Classify: S if s[i] < s[i + 1] (or equal and s[i + 1] is S) */
+    isS[n - 1] = 0;
+    for (i = n - 2; i >= 0; i--) isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+
+    /* Bucket starts: sumL[c] = first L slot, sumS[c] = first S slot */
+    for (i = 0; i < n; i++) {
+        if (!isS[i]) sumS[s[i]]++;
+        else sumL[s[i] + 1]++;
+    }
+    for (i = 0; i <= upper; i++) {
+        sumS[i] += sumL[i];
+        if (i < upper) sumL[i + 1] += sumS[i];
+    }
+
+    /* 2. LMS positions (S preceded by L) */
+    m = 0;
+    for (i = 0; i <= n; i++) lmsMap[i] = -1;
+    for (i = 1; i < n; i++)
+        if (!isS[i - 1] && isS[i]) lmsMap[i] = m++;
+    lms = (SaIndex*)malloc(sizeof(SaIndex) * (m ? m : 1));
+    m = 0;
+    for (i = 1; i < n; i++)
+        if (!isS[i - 1] && isS[i]) lms[m++] = i;
+
+    saInduce(s, n, upper, isS, sumL, sumS, lms, m, sa, buf);
+
+    if (m > 0) {
+        /* 3. Name the LMS substrings in sorted order; equal ones share a name */
+        sortedLms = (SaIndex*)malloc(sizeof(SaIndex) * m);
+        recS = (SaIndex*)malloc(sizeof(SaIndex) * m);
+        recSa = (SaIndex*)malloc(sizeof(SaIndex) * m);
+        if (!sortedLms || !recS || !recSa) {
+            ok = 0;
+        } else {
+            SaIndex k = 0;
+            for (i = 0; i < n; i++)
+                if (lmsMap[sa[i]] != -1) sortedLms[k++] = sa[i];
+
+            recUpper = 0;
+            recS[lmsMap[sortedLms[0]]] = 0;
+            for (i = 1; i < m; i++) {
+                l = sortedLms[i - 1];
+                r = sortedLms[i];
+                endL = (lmsMap[l] + 1 < m) ? lms[lmsMap[l] + 1] : n;
+                endR = (lmsMap[r] + 1 < m) ? lms[lmsMap[r] + 1] : n;
+                same = 1;
+                if (endL - l != endR - r) {
+                    same = 0;
+                } else {
+                    while (l < endL && s[l] == s[r]) { l++; r++; }
+                    if (l == n || s[l] != s[r]) same = 0;
+                }
+                if (!same) recUpper++;
+                recS[lmsMap[sortedLms[i]]] = recUpper;
+            }
+
+            /* 4. Sort the reduced string, then induce the final order */
+            ok = saIs(recS, m, recUpper, recSa);
+            if (ok) {
+                for (i = 0; i < m; i++) sortedLms[i] = lms[recSa[i]];
+                saInduce(s, n, upper, isS, sumL, sumS, sortedLms, m, sa, buf);
+            }
+        }
+        free(sortedLms);
+        free(recS);
+        free(recSa);
+    }
+
+    free(isS);
+    free(sumL);
+    free(sumS);
+    free(buf);
+    free(lmsMap);
+    free(lms);
+    return ok;
+}
+
+/* Kasai et al.: walks suffixes in text order; the LCP drops by at most one
+   per step, so the total work is O(n). */
+static int buildLcp(struct SuffixIndex* idx) {
+    SaIndex i, j, h = 0, n = idx->n;
+    SaIndex* rank = (SaIndex*)malloc(sizeof(SaIndex) * (n ? n : 1));
+    if (rank == NULL) return 0;
+    for (i = 0; i < n; i++) rank[idx->sa[i]] = i;
+    if (n > 0) idx->lcp[0] = 0;
+    for (i = 0; i < n; i++) {
+        if (rank[i] == 0) { h = 0; continue; }
+        j = idx->sa[rank[i] - 1];
+        while (i + h < n && j + h < n && idx->text[i + h] == idx->text[j + h]) h++;
+        idx->lcp[rank[i]] = h;
+        if (h > 0) h--;
+    }
+    free(rank);
+    return 1;
+}
+
+void freeSuffixIndex(struct SuffixIndex* idx) {
+    if (idx == NULL) return;
+    free(idx->text);
+    free(idx->sa);
+    free(idx->lcp);
+    free(idx);
+}
+
+static struct SuffixIndex* allocSuffixIndex(SaIndex n) {
+    struct SuffixIndex* idx = (struct SuffixIndex*)calloc(1, sizeof(struct SuffixIndex));
+    if (idx == NULL) return NULL;
+    idx->n = n;
+    idx->text = (unsigned char*)malloc(n ? n : 1);
+    idx->sa = (SaIndex*)malloc(sizeof(SaIndex) * (n ? n : 1));
+    idx->lcp = (SaIndex*)malloc(sizeof(SaIndex) * (n ? n : 1));
+    if (!idx->text || !idx->sa || !idx->lcp) {
+        freeSuffixIndex(idx);
+        return NULL;
+    }
+    return idx;
+}
+
+/* Copies text[0, n) and indexes it. Returns NULL on failure. */
+struct SuffixIndex* buildSuffixIndex(const char* text, size_t n) {
+    struct SuffixIndex* idx;
+    SaIndex* s;
+    SaIndex i;
+
+    if ((SaIndex)n < 0 || (size_t)(SaIndex)n != n) return NULL; /* Needs SA_LARGE_TEXT */
+    idx = allocSuffixIndex((SaIndex)n);
+    if (idx == NULL) return NULL;
+    memcpy(idx->text, text, n);
+
+    s = (SaIndex*)malloc(sizeof(SaIndex) * (n ? n : 1));
+    if (s == NULL) { freeSuffixIndex(idx); return NULL; }
+    for (i = 0; i < idx->n; i++) s[i] = idx->text[i];
+    if (!saIs(s, idx->n, 255, idx->sa) || !buildLcp(idx)) {
+        free(s);
+        freeSuffixIndex(idx);
+        return NULL;
+    }
+    free(s);
+    return idx;
+}
+
+/* Compares the suffix at 'pos' with pat[0, m) over at most m bytes */
+static int suffixCompare(const struct SuffixIndex* idx, SaIndex pos, const unsigned char* pat, size_t m) {
+    size_t avail = (size_t)(idx->n - pos);
+    int c = memcmp(idx->text + pos, pat, avail < m ? avail : m);
+    if (c != 0) return c;
+    return (avail < m) ? -1 : 0; /* A shorter suffix sorts first */
+}
+
+/* Number of occurrences of pat; they are sa[*first .. *first + count) */
+SaIndex suffixRange(const struct SuffixIndex* idx, const char* pat, size_t m, SaIndex* first) {
+    const unsigned char* p = (const unsigned char*)pat;
+    SaIndex lo = 0, hi = idx->n, mid, begin;
+
+    while (lo < hi) { /* First suffix >= pat */
+        mid = lo + (hi - lo) / 2;
+        if (suffixCompare(idx, idx->sa[mid], p, m) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    begin = lo;
+    hi = idx->n;
+    while (lo < hi) { /* First suffix that does not start with pat */
+        mid = lo + (hi - lo) / 2;
+        if (suffixCompare(idx, idx->sa[mid], p, m) == 0) lo = mid + 1;
+        else hi = mid;
+    }
+    *first = begin;
+    return lo - begin;
+}
+
+/* Length of the longest substring occurring at least twice; *pos gets one
+   of its start offsets. It is the largest LCP between sorted neighbours. */
+SaIndex longestRepeatedSubstring(const struct SuffixIndex* idx, SaIndex* pos) {
+    SaIndex i, best = 0;
+    *pos = 0;
+    for (i = 1; i < idx->n; i++) {
+        if (idx->lcp[i] > best) {
+            best = idx->lcp[i];
+            *pos = idx->sa[i];
+        }
+    }
+    return best;
+}
+
+/* On-disk format: "SAX1", index width (1 byte), n (8 bytes), text, sa, lcp.
+   Written to path.tmp and renamed, so a crash never leaves a torn file. */
+int saveSuffixIndex(const struct SuffixIndex* idx, const char* path) {
+    char tmp[1024];
+    FILE* f;
+    unsigned long long n = (unsigned long long)idx->n;
+    unsigned char width = (unsigned char)sizeof(SaIndex);
+    int ok;
+
+    if (strlen(path) + 5 > sizeof(tmp)) return 0;
+    sprintf(tmp, "%s.tmp", path);
+    f = fopen(tmp, "wb");
+    if (f == NULL) return 0;
+    ok = fwrite(SA_MAGIC, 1, 4, f) == 4 &&
+         fwrite(&width, 1, 1, f) == 1 &&
+         fwrite(&n, sizeof(n), 1, f) == 1 &&
+         fwrite(idx->text, 1, (size_t)n, f) == (size_t)n &&
+         fwrite(idx->sa, sizeof(SaIndex), (size_t)n, f) == (size_t)n &&
+         fwrite(idx->lcp, sizeof(SaIndex), (size_t)n, f) == (size_t)n;
+    ok = (fclose(f) == 0) && ok;
+    if (ok) ok = (rename(tmp, path) == 0);
+    if (!ok) remove(tmp);
+    return ok;
+}
+
+/* Returns NULL if the file is missing, truncated or built with another width */
+struct SuffixIndex* loadSuffixIndex(const char* path) {
+    struct SuffixIndex* idx = NULL;
+    char magic[4];
+    unsigned char width;
+    unsigned long long n;
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+
+    if (fread(magic, 1, 4, f) == 4 && memcmp(magic, SA_MAGIC, 4) == 0 &&
+        fread(&width, 1, 1, f) == 1 && width == sizeof(SaIndex) &&
+        fread(&n, sizeof(n), 1, f) == 1 && (SaIndex)n >= 0 && (unsigned long long)(SaIndex)n == n) {
+        idx = allocSuffixIndex((SaIndex)n);
+        if (idx != NULL &&
+            (fread(idx->text, 1, (size_t)n, f) != (size_t)n ||
+             fread(idx->sa, sizeof(SaIndex), (size_t)n, f) != (size_t)n ||
+             fread(idx->lcp, sizeof(SaIndex), (size_t)n, f) != (size_t)n)) {
+            freeSuffixIndex(idx);
+            idx = NULL;
+        }
+    }
+    fclose(f);
+    return idx;
+}
+
+/* --- Index benchmark --- */
+
+void benchmarkSuffixIndex(size_t n, int queries, const char* path) {
+    char* txt = makeLogText(n);
+    struct SuffixIndex* idx;
+    struct SuffixIndex* loaded;
+    SaIndex first, count, lrsPos, lrsLen, i;
+    size_t total = 0, scanned = 0, pos;
+    double start, buildSecs, querySecs, scanSecs;
+    unsigned int seed = 4711;
+    int q, scanQueries = 5, bad = 0;
+    char pat[16];
+
+    if (txt == NULL) { printf("Memory allocation failed\n"); return; }
+    start = wallSeconds();
+    idx = buildSuffixIndex(txt, n);
+    buildSecs = wallSeconds() - start;
+    if (idx == NULL) { printf("Index build failed\n"); free(txt); return; }
+
+    printf("\n--- Suffix Index (%lu MB log) ---\n", (unsigned long)(n >> 20));
+    printf("SA-IS + LCP build: %.2f s (%.1f MB/s), %lu bytes of index\n", buildSecs, n / buildSecs / 1e6,
+           (unsigned long)(2 * sizeof(SaIndex) * n));
+
+    /* Random 8-byte substrings of the text as queries */
+    start = wallSeconds();
+    for (q = 0; q < queries; q++) {
+        seed = seed * 1103515245u + 12345u;
+        pos = ((size_t)seed * 2654435761u) % (n - 8);
+        count = suffixRange(idx, txt + pos, 8, &first);
+        total += (size_t)count;
+    }
+    querySecs = wallSeconds() - start;
+
+    /* The same kind of query answered by rescanning the text */
+    start = wallSeconds();
+    seed = 4711;
+    for (q = 0; q < scanQueries; q++) {
+        seed = seed * 1103515245u + 12345u;
+        pos = ((size_t)seed * 2654435761u) % (n - 8);
+        memcpy(pat, txt + pos, 8);
+        count = suffixRange(idx, pat, 8, &first);
+        scanned = searchAll(txt, n, pat, 8, NULL, NULL);
+        if ((size_t)count != scanned) bad++;
+    }
+    scanSecs = (wallSeconds() - start) / scanQueries;
+
+    printf("Indexed query: %.2f us (%d queries, %lu occurrences)\n", querySecs / queries * 1e6, queries,
+           (unsigned long)total);
+    printf("Full-text scan: %.2f ms per query (%.0fx slower), counts %s\n", scanSecs * 1e3,
+           scanSecs / (querySecs / queries), bad ? "MISMATCH" : "agree");
+
+    lrsLen = longestRepeatedSubstring(idx, &lrsPos);
+    printf("Longest repeated substring: %ld bytes at offset %ld\n", (long)lrsLen, (long)lrsPos);
+
+    start = wallSeconds();
+    if (!saveSuffixIndex(idx, path)) {
+        printf("Could not write %s\n", path);
+    } else {
+        double saveSecs = wallSeconds() - start;
+        start = wallSeconds();
+        loaded = loadSuffixIndex(path);
+        printf("Save %.2f s, load %.2f s (rebuild %.2f s)", saveSecs, wallSeconds() - start, buildSecs);
+        if (loaded != NULL) {
+            for (i = 0; i < idx->n && !bad; i++)
+                if (loaded->sa[i] != idx->sa[i] || loaded->lcp[i] != idx->lcp[i]) bad++;
+            printf(", reloaded index %s\n", bad ? "DIFFERS" : "identical");
+            freeSuffixIndex(loaded);
+        } else {
+            printf(", reload FAILED\n");
+        }
+    }
+
+    freeSuffixIndex(idx);
+    free(txt);
+}
+
+/* ---------------------------------------------------------
+   7. EDIT DISTANCE ENGINE (Myers/Hyyro, Ukkonen Band, Batch)
+   --------------------------------------------------------- */
+
+/* editDistance() above fills an (m+1) x (n+1) table. These compute the
+   same Levenshtein distance with far less work:
+     editDistanceFast    : bit-parallel (Myers 1999, Hyyro 2001). A column
+                           of the DP table is two bit vectors (+1 / -1
+                           vertical deltas), updated for one text byte with
+                           ~15 word operations. One 64-bit word covers
+                           strings up to 64 bytes; longer ones use blocks
+                           of 64 rows with carries between them.
+     editDistanceBounded : the same bit vectors, but only the 64-row
+                           blocks that meet the diagonal band |i - j| <= k
+                           (Ukkonen), stopping once the whole band
+                           exceeds k.
+     editDistanceBatch   : many short pairs at once, one pair per SIMD lane
+                           running the single-word algorithm.
+   The shorter string is always the "pattern" (the bit-vector rows). */
+
+#define ED_WORD 64
+
+typedef unsigned long long EdWord;
+
+/* Per-byte match masks of pattern p[0, m) for block 'blk' (64 rows) */
+static void edBuildPeq(const unsigned char* p, long m, long blk, EdWord* peq) {
+    long i, end = (blk + 1) * ED_WORD < m ? (blk + 1) * ED_WORD : m;
+    memset(peq, 0, sizeof(EdWord) * 256);
+    for (i = blk * ED_WORD; i < end; i++) peq[p[i]] |= 1ULL << (i - blk * ED_WORD);
+}
+
+/* One 64-row block for one text byte. hin/return: horizontal delta
+   (+1, 0, -1) entering at the block's top row and leaving at row 'outBit'. */
+static int edAdvanceBlock(EdWord* pv, EdWord* mv, EdWord eq, int hin, EdWord outBit) {
+    EdWord xv, xh, ph, mh;
+    int hout;
+    xv = eq | *mv;
+    if (hin < 0) eq |= 1;
+    xh = (((eq & *pv) + *pv) ^ *pv) | eq;
+    ph = *mv | ~(xh | *pv);
+    mh = *pv & xh;
+    hout = (ph & outBit) ? 1 : ((mh & outBit) ? -1 : 0);
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) mh |= 1;
+    else if (hin > 0) ph |= 1;
+    *pv = mh | ~(xv | ph);
+    *mv = ph & xv;
+    return hout;
+}
+
+int editDistanceFast(const char* a, size_t lenA, const char* b, size_t lenB) {
+    const unsigned char *p, *t;
+    long m, n, j, blk, blocks;
+    EdWord *peq, *pv, *mv, lastBit;
+    int score, hin;
+
+    /* Pattern = shorter string */
+    if (lenA <= lenB) { p = (const unsigned char*)a; m = (long)lenA; t = (const unsigned char*)b; n = (long)lenB; }
+    else { p = (const unsigned char*)b; m = (long)lenB; t = (const unsigned char*)a; n = (long)lenA; }
+    if (m == 0) return (int)n;
+
+    blocks = (m + ED_WORD - 1) / ED_WORD;
+    peq = (EdWord*)malloc(sizeof(EdWord) * 256 * blocks);
+    pv = (EdWord*)malloc(sizeof(EdWord) * blocks);
+    mv = (EdWord*)malloc(sizeof(EdWord) * blocks);
+    if (!peq || !pv || !mv) { free(peq); free(pv); free(mv); return -1; }
+    for (blk = 0; blk < blocks; blk++) {
+        edBuildPeq(p, m, blk, peq + 256 * blk);
+        pv[blk] = ~0ULL;  /* Column 0: D[i][0] = i, all vertical deltas +1 */
+        mv[blk] = 0;
+    }
+    lastBit = 1ULL << ((m - 1) % ED_WORD);
+    score = (int)m;
+
+    for (j = 0; j < n; j++) {
+        hin = 1; /* Row 0: D[0][j] = j */
+        for (blk = 0; blk < blocks - 1; blk++)
+            hin = edAdvanceBlock(&pv[blk], &mv[blk], peq[256 * blk + t[j]], hin, 1ULL << 63);
+        score += edAdvanceBlock(&pv[blk], &mv[blk], peq[256 * blk + t[j]], hin, lastBit);
+    }
+
+    free(peq);
+    free(pv);
+    free(mv);
+    return score;
+}
+
+/* Distance if it is <= k, otherwise -1. The bit-parallel columns of
+   editDistanceFast, restricted to the blocks that meet the diagonal band
+   |i - j| <= k (Ukkonen). Every cell off the band is > k, so for column j:
+     - blocks wholly above the band are frozen for good; the next block
+       reads their bottom row as growing by one per column (hin = +1),
+     - blocks wholly below the band are not started yet; when the band
+       reaches one it starts as "one more than the row above" (all +1).
+   Both guesses can only overestimate, and only cells that are already
+   > k, so every cell <= k comes out exact. The scan stops early once
+   every band block is > k even at its best row (a block's rows differ by
+   at most one each from its bottom score). */
+int editDistanceBounded(const char* a, size_t lenA, const char* b, size_t lenB, int k) {
+    const unsigned char *p, *t;
+    long m, n, j, blk, blocks, first, last, rows;
+    EdWord *peq, *pv, *mv;
+    long* score;
+    int hin, result;
+
+    if (k < 0) return -1;
+    if (lenA <= lenB) { p = (const unsigned char*)a; m = (long)lenA; t = (const unsigned char*)b; n = (long)lenB; }
+    else { p = (const unsigned char*)b; m = (long)lenB; t = (const unsigned char*)a; n = (long)lenA; }
+    if (n - m > k) return -1; /* Length gap alone exceeds k */
+    if (m == 0) return (int)n;
+
+    blocks = (m + ED_WORD - 1) / ED_WORD;
+    peq = (EdWord*)malloc(sizeof(EdWord) * 256 * blocks);
+    pv = (EdWord*)malloc(sizeof(EdWord) * blocks);
+    mv = (EdWord*)malloc(sizeof(EdWord) * blocks);
+    score = (long*)malloc(sizeof(long) * blocks); /* D at each block's bottom row */
+    if (!peq || !pv || !mv || !score) { free(peq); free(pv); free(mv); free(score); return -1; }
+    for (blk = 0; blk < blocks; blk++) edBuildPeq(p, m, blk, peq + 256 * blk);
+
+    /* Column 0: D[i][0] = i, only down to row k */
+    first = 0;
+    last = ((k < m ? k : m) - 1) / ED_WORD;
+    if (k == 0) last = 0;
+    for (blk = 0; blk <= last; blk++) {
+        pv[blk] = ~0ULL;
+        mv[blk] = 0;
+        score[blk] = (blk + 1) * ED_WORD < m ? (blk + 1) * ED_WORD : m;
+    }
+    result = -1;
+
+    for (j = 0; j < n; j++) {
+        long col = j + 1, bottom, limit = col + k < m ? col + k : m;
+        int dead = 1;
+
+        /* Start the blocks the band has reached */
+        while ((last + 1) * ED_WORD < limit) {
+            last++;
+            pv[last] = ~0ULL;
+            mv[last] = 0;
+            rows = (last + 1) * ED_WORD < m ? ED_WORD : m - last * ED_WORD;
+            score[last] = score[last - 1] + rows;
+        }
+        /* Freeze blocks whose bottom row has left the band (never the last) */
+        while (first < blocks - 1 && (first + 1) * ED_WORD < col - k) first++;
+
+        hin = 1; /* Row 0 (D[0][j] = j) or a frozen block: +1 either way */
+        for (blk = first; blk <= last; blk++) {
+            bottom = (blk + 1) * ED_WORD < m ? ED_WORD : m - blk * ED_WORD;
+            hin = edAdvanceBlock(&pv[blk], &mv[blk], peq[256 * blk + t[j]], hin, 1ULL << (bottom - 1));
+            score[blk] += hin;
+            if (score[blk] - (bottom - 1) <= k) dead = 0;
+        }
+        if (dead) goto done; /* The whole band is > k */
+    }
+    if (score[blocks - 1] <= k) result = (int)score[blocks - 1];
+
+done:
+    free(peq);
+    free(pv);
+    free(mv);
+    free(score);
+    return result;
+}
+
+/* --- Batch mode: one pair per SIMD lane ---
+   A vector of ED_VECTOR_BYTES holds 8 lanes of 32 bits (pairs whose shorter
+   string is <= 32 bytes) or 4 lanes of 64 bits (<= 64 bytes). With AVX2
+   that is one register; otherwise the compiler splits it into SSE2 halves. */
+
+#define ED_VECTOR_BYTES 32
+#define ED_MAX_LANES 8
+#define ED_SORT_BUCKETS 256 /* Longer texts share the last bucket */
+
+struct EdPair {
+    const unsigned char* p;  /* Shorter string, <= 64 bytes */
+    const unsigned char* t;
+    long m, n;
+    int index;               /* Position in the caller's arrays */
+};
+
+/* One text column for all lanes; 'active' freezes lanes whose text ended.
+   Vector comparisons give -1 in true lanes. */
+#define ED_LANE_STEP(Signed, active)                                          \
+    do {                                                                      \
+        xv = eq | mv;                                                         \
+        xh = (((eq & pv) + pv) ^ pv) | eq;                                    \
+        ph = mv | ~(xh | pv);                                                 \
+        mh = pv & xh;                                                         \
+        score += (Signed)(((mh & top) != 0) & (Signed)(active))               \
+               - (Signed)(((ph & top) != 0) & (Signed)(active));              \
+        ph = (ph << 1) | 1;                                                   \
+        mh = mh << 1;                                                         \
+        pv = ((mh | ~(xv | ph)) & (active)) | (pv & ~(active));               \
+        mv = ((ph & xv) & (active)) | (mv & ~(active));                       \
+    } while (0)
+
+/* Runs the single-word algorithm for up to LANES pairs in lockstep:
+   unmasked up to the shortest text, masked after that. */
+#define DEFINE_ED_BATCH_GROUP(name, Word, SignedWord)                                      \
+    typedef Word name##Lanes __attribute__((vector_size(ED_VECTOR_BYTES)));                \
+    typedef SignedWord name##Scores __attribute__((vector_size(ED_VECTOR_BYTES)));         \
+    enum { name##Width = ED_VECTOR_BYTES / sizeof(Word) };                                 \
+    static void name(const struct EdPair* pairs, int lanes, EdWord (*peq)[256], int* out) { \
+        static const unsigned char none = 0;                                               \
+        const unsigned char* txt[name##Width];                                             \
+        name##Lanes pv, mv, eq, xv, xh, ph, mh, top, active, all;                          \
+        name##Scores score;                                                                \
+        long j, minN = -1, maxN = 0, n[name##Width];                                       \
+        int l;                                                                             \
+        for (l = 0; l < name##Width; l++) {                                                \
+            pv[l] = (Word)~0ULL;                                                           \
+            mv[l] = 0;                                                                     \
+            all[l] = (Word)~0ULL;                                                          \
+            top[l] = (l < lanes) ? (Word)(1ULL << (pairs[l].m - 1)) : 0;                   \
+            score[l] = (l < lanes) ? pairs[l].m : 0;                                       \
+            txt[l] = (l < lanes) ? pairs[l].t : &none;                                     \
+            n[l] = (l < lanes) ? pairs[l].n : 0;                                           \
+            if (l < lanes && (minN < 0 || n[l] < minN)) minN = n[l];                       \
+            if (n[l] > maxN) maxN = n[l];                                                  \
+        }                                                                                  \
+        for (j = 0; j < minN; j++) {                                                       \
+            for (l = 0; l < name##Width; l++) eq[l] = (Word)peq[l][txt[l][l < lanes ? j : 0]]; \
+            ED_LANE_STEP(name##Scores, all);                                               \
+        }                                                                                  \
+        for (; j < maxN; j++) {                                                            \
+            for (l = 0; l < name##Width; l++) {                                            \
+                active[l] = (j < n[l]) ? (Word)~0ULL : 0;                                  \
+                eq[l] = active[l] ? (Word)peq[l][txt[l][j]] : 0;                           \
+            }                                                                              \
+            ED_LANE_STEP(name##Scores, active);                                            \
+        }                                                                                  \
+        for (l = 0; l < lanes; l++) out[pairs[l].index] = (int)score[l];                   \
+    }
+
+DEFINE_ED_BATCH_GROUP(edBatchGroup32, unsigned int, int)
+DEFINE_ED_BATCH_GROUP(edBatchGroup64, EdWord, long long)
+
+/* Counting sort by text length into dst: similar lengths per group waste
+   fewer frozen-lane steps */
+static void edSortByTextLength(const struct EdPair* src, int count, struct EdPair* dst) {
+    int start[ED_SORT_BUCKETS + 1];
+    int i;
+    memset(start, 0, sizeof(start));
+    for (i = 0; i < count; i++)
+        start[(src[i].n < ED_SORT_BUCKETS - 1 ? src[i].n : ED_SORT_BUCKETS - 1) + 1]++;
+    for (i = 0; i < ED_SORT_BUCKETS; i++) start[i + 1] += start[i];
+    for (i = 0; i < count; i++)
+        dst[start[src[i].n < ED_SORT_BUCKETS - 1 ? src[i].n : ED_SORT_BUCKETS - 1]++] = src[i];
+}
+
+/* out[i] = distance(as[i], bs[i]). Pairs whose shorter string is longer
+   than 64 bytes go through editDistanceFast one at a time. */
+void editDistanceBatch(const char* const* as, const char* const* bs, int count, int* out) {
+    struct EdPair* pairs = (struct EdPair*)malloc(sizeof(struct EdPair) * (count ? count : 1));
+    struct EdPair* sorted = (struct EdPair*)malloc(sizeof(struct EdPair) * (count ? count : 1));
+    EdWord (*peq)[256] = (EdWord (*)[256])malloc(sizeof(EdWord) * 256 * ED_MAX_LANES);
+    int i, g, l, lanes, width, narrow = 0, numPairs = 0;
+    size_t la, lb;
+    long c;
+
+    if (pairs == NULL || sorted == NULL || peq == NULL) {
+        for (i = 0; i < count; i++) out[i] = editDistanceFast(as[i], strlen(as[i]), bs[i], strlen(bs[i]));
+        free(pairs);
+        free(sorted);
+        free(peq);
+        return;
+    }
+    memset(peq, 0, sizeof(EdWord) * 256 * ED_MAX_LANES);
+
+    /* Narrow pairs (<= 32) fill the front of 'pairs', wide ones the back */
+    for (i = 0; i < count; i++) {
+        struct EdPair pr;
+        la = strlen(as[i]);
+        lb = strlen(bs[i]);
+        if ((la < lb ? la : lb) > ED_WORD || la == 0 || lb == 0) {
+            out[i] = editDistanceFast(as[i], la, bs[i], lb);
+            continue;
+        }
+        pr.p = (const unsigned char*)(la <= lb ? as[i] : bs[i]);
+        pr.t = (const unsigned char*)(la <= lb ? bs[i] : as[i]);
+        pr.m = (long)(la <= lb ? la : lb);
+        pr.n = (long)(la <= lb ? lb : la);
+        pr.index = i;
+        if (pr.m <= 32) {
+            pairs[numPairs++] = pairs[narrow];
+            pairs[narrow++] = pr;
+        } else {
+            pairs[numPairs++] = pr;
+        }
+    }
+    edSortByTextLength(pairs, narrow, sorted);
+    edSortByTextLength(pairs + narrow, numPairs - narrow, sorted + narrow);
+
+    for (g = 0; g < numPairs; g += lanes) {
+        width = (g < narrow) ? edBatchGroup32Width : edBatchGroup64Width;
+        lanes = ((g < narrow ? narrow : numPairs) - g < width) ? (g < narrow ? narrow : numPairs) - g : width;
+        for (l = 0; l < lanes; l++)
+            for (c = 0; c < sorted[g + l].m; c++) peq[l][sorted[g + l].p[c]] |= 1ULL << c;
+        if (g < narrow) edBatchGroup32(sorted + g, lanes, peq, out);
+        else edBatchGroup64(sorted + g, lanes, peq, out);
+        for (l = 0; l < lanes; l++) /* Clear only what was set */
+            for (c = 0; c < sorted[g + l].m; c++) peq[l][sorted[g + l].p[c]] = 0;
+    }
+    free(pairs);
+    free(sorted);
+    free(peq);
+}
+
+/* --- Name-pair benchmark --- */
+
+static char* randomName(unsigned int* seed, int minLen, int maxLen) {
+    int len, i;
+    char* s;
+    *seed = *seed * 1103515245u + 12345u;
+    len = minLen + (int)((*seed >> 16) % (unsigned)(maxLen - minLen + 1));
+    s = (char*)malloc(len + 4);
+    for (i = 0; i < len; i++) {
+        *seed = *seed * 1103515245u + 12345u;
+        s[i] = (char)('a' + (*seed >> 16) % 26);
+    }
+    s[len] = '\0';
+    return s;
+}
+
+/* Copy of src with up to 'edits' random substitutions/insertions/deletions */
+static char* mutateName(const char* src, unsigned int* seed, int edits) {
+    size_t len = strlen(src);
+    char* s = (char*)malloc(len + edits + 1);
+    size_t pos;
+    int e;
+    memcpy(s, src, len + 1);
+    for (e = 0; e < edits; e++) {
+        *seed = *seed * 1103515245u + 12345u;
+        pos = (*seed >> 8) % (len + 1);
+        switch ((*seed >> 20) % 3) {
+        case 0: if (pos < len) s[pos] = (char)('a' + (*seed >> 24) % 26); break;
+        case 1: memmove(s + pos + 1, s + pos, len - pos + 1); s[pos] = 'x'; len++; break;
+        default: if (pos < len) { memmove(s + pos, s + pos + 1, len - pos); len--; } break;
+        }
+    }
+    return s;
+}
+
+static void benchmarkPairs(const char* label, char** as, char** bs, int count, int k) {
+    int* expect = (int*)malloc(sizeof(int) * count);
+    int* got = (int*)malloc(sizeof(int) * count);
+    int i, bad, within;
+    double start, secs, base;
+
+    start = wallSeconds();
+    for (i = 0; i < count; i++) expect[i] = editDistanceTable(as[i], bs[i]);
+    base = wallSeconds() - start;
+    printf("%-7s %-22s %12.0f pairs/s\n", label, "full table", count / base);
+
+    start = wallSeconds();
+    for (bad = 0, i = 0; i < count; i++)
+        if (editDistanceFast(as[i], strlen(as[i]), bs[i], strlen(bs[i])) != expect[i]) bad++;
+    secs = wallSeconds() - start;
+    printf("%-7s %-22s %12.0f pairs/s %6.1fx %s\n", "", "bit-parallel", count / secs, base / secs, bad ? "MISMATCH" : "ok");
+
+    start = wallSeconds();
+    for (bad = 0, within = 0, i = 0; i < count; i++) {
+        int r = editDistanceBounded(as[i], strlen(as[i]), bs[i], strlen(bs[i]), k);
+        if (r >= 0) within++;
+        if ((r >= 0) != (expect[i] <= k) || (r >= 0 && r != expect[i])) bad++;
+    }
+    secs = wallSeconds() - start;
+    printf("%-7s banded, k = %-11d %12.0f pairs/s %6.1fx %s (%d within k)\n", "", k, count / secs, base / secs,
+           bad ? "MISMATCH" : "ok", within);
+
+    start = wallSeconds();
+    editDistanceBatch((const char* const*)as, (const char* const*)bs, count, got);
+    secs = wallSeconds() - start;
+    for (bad = 0, i = 0; i < count; i++) if (got[i] != expect[i]) bad++;
+    printf("%-7s %-22s %12.0f pairs/s %6.1fx %s\n", "", "batch (SIMD lanes)", count / secs, base / secs, bad ? "MISMATCH" : "ok");
+
+    free(expect);
+    free(got);
+}
+
+void benchmarkEditDistance(int numPairs) {
+    int longPairs = 200, i;
+    char** as = (char**)malloc(sizeof(char*) * numPairs);
+    char** bs = (char**)malloc(sizeof(char*) * numPairs);
+    unsigned int seed = 2718;
+
+    printf("\n--- Edit Distance Engines ---\n");
+    for (i = 0; i < numPairs; i++) {
+        as[i] = randomName(&seed, 5, 20);
+        bs[i] = mutateName(as[i], &seed, (int)(seed >> 28) % 4);
+    }
+    benchmarkPairs("names", as, bs, numPairs, 2);
+    for (i = 0; i < numPairs; i++) { free(as[i]); free(bs[i]); }
+
+    /* Long strings take the multi-word path */
+    for (i = 0; i < longPairs; i++) {
+        as[i] = randomName(&seed, 1500, 2500);
+        bs[i] = mutateName(as[i], &seed, 50);
+    }
+    benchmarkPairs("long", as, bs, longPairs, 64);
+    for (i = 0; i < longPairs; i++) { free(as[i]); free(bs[i]); }
+    free(as);
+    free(bs);
+}
+
+/* ---------------------------------------------------------
+   8. LCS ENGINE (Bit-Parallel, Hirschberg, Wavefront)
+   --------------------------------------------------------- */
+
+/* lcsLengthTable() above needs (m+1) x (n+1) ints: two 1 MB inputs would
+   take 4 TB. These keep O(m + n) memory:
+     lcsLength         : bit-parallel (Allison-Dix 1986, Hyyro 2004). Row i
+                         of a DP column is one bit, cleared where the LCS
+                         grows at row i; one text byte updates 64 rows with
+                         an AND, an ADD and an OR.
+     lcsString         : Hirschberg's divide and conquer. The forward and
+                         backward score rows come from the same bit vectors,
+                         so recovering the subsequence costs ~2x the length.
+     lcsLengthParallel : the bit vectors cut into tiles of LCS_TILE_WORDS
+                         words x LCS_TILE_COLS text bytes. Tile (r, c) needs
+                         tile (r, c - 1) and the carries out of (r - 1, c),
+                         so all tiles on one anti-diagonal run at once.
+   Vectors use EdWord from section 7. Common prefixes and suffixes are
+   stripped first, which is most of the work when diffing similar files. */
+
+#define LCS_TILE_WORDS 32   /* 2048 pattern rows */
+#define LCS_TILE_COLS 4096  /* Text bytes */
+#define LCS_BASE_CELLS 4096 /* Hirschberg: plain table below this many cells */
+
+/* Strips the common prefix and suffix; returns how many bytes went */
+static long lcsTrim(const unsigned char** a, long* m, const unsigned char** b, long* n) {
+    long pre = 0, suf = 0;
+    while (pre < *m && pre < *n && (*a)[pre] == (*b)[pre]) pre++;
+    while (suf < *m - pre && suf < *n - pre && (*a)[*m - 1 - suf] == (*b)[*n - 1 - suf]) suf++;
+    *a += pre;
+    *b += pre;
+    *m -= pre + suf;
+    *n -= pre + suf;
+    return pre + suf;
+}
+
+/* Match masks of p[0, m), read backwards if 'reverse': peq[c * words + w] */
+static EdWord* lcsBuildPeq(const unsigned char* p, long m, int reverse, long words) {
+    EdWord* peq = (EdWord*)calloc((size_t)256 * words, sizeof(EdWord));
+    long i;
+    if (peq == NULL) return NULL;
+    for (i = 0; i < m; i++)
+        peq[(reverse ? p[m - 1 - i] : p[i]) * words + i / ED_WORD] |= 1ULL << (i % ED_WORD);
+    return peq;
+}
+
+/* Words [w0, w1) of v for one text byte: V' = (V + (V & M)) | (V & ~M).
+   The addition carries across words; returns the carry out of w1 - 1. */
+static int lcsAdvanceWords(EdWord* v, const EdWord* eq, long w0, long w1, int carry) {
+    EdWord u, sum;
+    long w;
+    int c;
+    for (w = w0; w < w1; w++) {
+        u = v[w] & eq[w];
+        sum = v[w] + u;
+        c = sum < u;
+        sum += (EdWord)carry;
+        c |= sum < (EdWord)carry;
+        v[w] = sum | (v[w] & ~u);
+        carry = c;
+    }
+    return carry;
+}
+
+/* Zero bits among the first m rows */
+static long lcsCountRows(const EdWord* v, long m) {
+    long w, zeros = 0;
+    for (w = 0; w < m / ED_WORD; w++) zeros += ED_WORD - __builtin_popcountll(v[w]);
+    if (m % ED_WORD) zeros += m % ED_WORD - __builtin_popcountll(v[w] & ((1ULL << (m % ED_WORD)) - 1));
+    return zeros;
+}
+
+long lcsLength(const char* a, size_t lenA, const char* b, size_t lenB) {
+    const unsigned char *p = (const unsigned char*)a, *t = (const unsigned char*)b, *swap;
+    long m = (long)lenA, n = (long)lenB, same, words, j, result;
+    EdWord *peq, *v;
 
-    for (i = 0; i <= m; i++) {
-        for (j = 0; j <= n; j++) {
-            if (i == 0 || j == 0)
-                L[i * (n + 1) + j] = 0;
-            else if (S1[i - 1] == S2[j - 1])
-                L[i * (n + 1) + j] = L[(i - 1) * (n + 1) + (j - 1)] + 1;
-            else
-                L[i * (n + 1) + j] = max_val(L[(i - 1) * (n + 1) + j], L[i * (n + 1) + (j - 1)]);
+    same = lcsTrim(&p, &m, &t, &n);
+    if (m > n) { swap = p; p = t; t = swap; j = m; m = n; n = j; } /* Pattern = shorter */
+    if (m == 0) return same;
+
+    words = (m + ED_WORD - 1) / ED_WORD;
+    peq = lcsBuildPeq(p, m, 0, words);
+    v = (EdWord*)malloc(sizeof(EdWord) * words);
+    if (!peq || !v) { free(peq); free(v); return -1; }
+    memset(v, 0xff, sizeof(EdWord) * words);
+    for (j = 0; j < n; j++) lcsAdvanceWords(v, peq + t[j] * words, 0, words, 0);
+    result = same + lcsCountRows(v, m);
+    free(peq);
+    free(v);
+    return result;
+}
+
+/* --- Hirschberg reconstruction --- */
+
+struct LcsOut {
+    char* buf;
+    long len;
+    long* fwd;  /* Score rows, lenB + 1 entries, reused at every level */
+    long* bwd;
+};
+
+/* score[i] = LCS(first i bytes of p, t) for i = 0..m; with 'reverse' both
+   strings are read from the end. Returns -1 if out of memory. */
+static int lcsPrefixScores(const unsigned char* p, long m, const unsigned char* t, long n, int reverse, long* score) {
+    long words = (m + ED_WORD - 1) / ED_WORD, i, j;
+    EdWord *peq, *v;
+    score[0] = 0;
+    if (m == 0) return 0;
+    peq = lcsBuildPeq(p, m, reverse, words);
+    v = (EdWord*)malloc(sizeof(EdWord) * words);
+    if (!peq || !v) { free(peq); free(v); return -1; }
+    memset(v, 0xff, sizeof(EdWord) * words);
+    for (j = 0; j < n; j++) lcsAdvanceWords(v, peq + (reverse ? t[n - 1 - j] : t[j]) * words, 0, words, 0);
+    for (i = 0; i < m; i++) score[i + 1] = score[i] + !((v[i / ED_WORD] >> (i % ED_WORD)) & 1);
+    free(peq);
+    free(v);
+    return 0;
+}
+
+/* Small subproblem: suffix table L[i][j] = LCS(a[i..], b[j..]), then walk
+   it from the top-left so bytes come out in order */
+static void lcsSmallTable(const unsigned char* a, long m, const unsigned char* b, long n, struct LcsOut* out) {
+    int L[LCS_BASE_CELLS];
+    long i, j, w = n + 1;
+    for (i = m; i >= 0; i--)
+        for (j = n; j >= 0; j--)
+            if (i == m || j == n) L[i * w + j] = 0;
+            else if (a[i] == b[j]) L[i * w + j] = L[(i + 1) * w + j + 1] + 1;
+            else L[i * w + j] = max_val(L[(i + 1) * w + j], L[i * w + j + 1]);
+    i = j = 0;
+    while (i < m && j < n) {
+        if (a[i] == b[j]) { out->buf[out->len++] = (char)a[i]; i++; j++; }
+        else if (L[(i + 1) * w + j] >= L[i * w + j + 1]) i++;
+        else j++;
+    }
+}
+
+static int lcsHirschberg(const unsigned char* a, long m, const unsigned char* b, long n, struct LcsOut* out) {
+    long pre = 0, suf, mid, j, split, best;
+    const unsigned char* tail;
+
+    while (pre < m && pre < n && a[pre] == b[pre]) out->buf[out->len++] = (char)a[pre++];
+    a += pre; b += pre; m -= pre; n -= pre;
+    for (suf = 0; suf < m && suf < n && a[m - 1 - suf] == b[n - 1 - suf]; suf++) ;
+    m -= suf;
+    n -= suf;
+    tail = a + m;
+
+    if (m == 0 || n == 0) {
+        /* Nothing left in the middle */
+    } else if (m == 1) {
+        if (memchr(b, a[0], n) != NULL) out->buf[out->len++] = (char)a[0];
+    } else if ((m + 1) * (n + 1) <= LCS_BASE_CELLS) {
+        lcsSmallTable(a, m, b, n, out);
+    } else {
+        /* Split a in half; b splits where forward + backward scores peak */
+        mid = m / 2;
+        if (lcsPrefixScores(b, n, a, mid, 0, out->fwd) < 0) return -1;
+        if (lcsPrefixScores(b, n, a + mid, m - mid, 1, out->bwd) < 0) return -1;
+        for (split = 0, best = -1, j = 0; j <= n; j++)
+            if (out->fwd[j] + out->bwd[n - j] > best) { best = out->fwd[j] + out->bwd[n - j]; split = j; }
+        if (lcsHirschberg(a, mid, b, split, out) < 0) return -1;
+        if (lcsHirschberg(a + mid, m - mid, b + split, n - split, out) < 0) return -1;
+    }
+    memcpy(out->buf + out->len, tail, suf);
+    out->len += suf;
+    return 0;
+}
+
+/* Malloc'd, NUL-terminated LCS of a and b (caller frees), or NULL if out
+   of memory. O(len(a) + len(b)) memory plus 256 bit vectors of the
+   shorter string. */
+char* lcsString(const char* a, size_t lenA, const char* b, size_t lenB, size_t* outLen) {
+    struct LcsOut out;
+    const char* swap;
+    size_t tmp;
+    int failed;
+
+    if (lenA < lenB) { swap = a; a = b; b = swap; tmp = lenA; lenA = lenB; lenB = tmp; } /* b = shorter */
+    out.buf = (char*)malloc(lenB + 1);
+    out.fwd = (long*)malloc(sizeof(long) * (lenB + 1));
+    out.bwd = (long*)malloc(sizeof(long) * (lenB + 1));
+    out.len = 0;
+    failed = !out.buf || !out.fwd || !out.bwd ||
+             lcsHirschberg((const unsigned char*)a, (long)lenA, (const unsigned char*)b, (long)lenB, &out) < 0;
+    free(out.fwd);
+    free(out.bwd);
+    if (failed) { free(out.buf); return NULL; }
+    out.buf[out.len] = '\0';
+    if (outLen) *outLen = (size_t)out.len;
+    return out.buf;
+}
+
+/* --- Anti-diagonal wavefront --- */
+
+struct LcsWave {
+    const unsigned char* t;
+    long n, words, rowBlocks, colChunks;
+    const EdWord* peq;
+    EdWord* v;
+    unsigned char* carry;  /* Per text byte: carry out of the row block above */
+    int threads;
+    pthread_barrier_t barrier;
+};
+
+struct LcsWaveJob {
+    struct LcsWave* wave;
+    int id;
+};
+
+static void* lcsWaveWorker(void* arg) {
+    struct LcsWaveJob* job = (struct LcsWaveJob*)arg;
+    struct LcsWave* wv = job->wave;
+    long diag, r, c, w0, w1, j, j1;
+
+    for (diag = 0; diag < wv->rowBlocks + wv->colChunks - 1; diag++) {
+        /* Tiles on one anti-diagonal touch disjoint words and columns */
+        for (r = job->id; r < wv->rowBlocks; r += wv->threads) {
+            c = diag - r;
+            if (c < 0 || c >= wv->colChunks) continue;
+            w0 = r * LCS_TILE_WORDS;
+            w1 = (w0 + LCS_TILE_WORDS < wv->words) ? w0 + LCS_TILE_WORDS : wv->words;
+            j1 = ((c + 1) * LCS_TILE_COLS < wv->n) ? (c + 1) * LCS_TILE_COLS : wv->n;
+            for (j = c * LCS_TILE_COLS; j < j1; j++)
+                wv->carry[j] = (unsigned char)lcsAdvanceWords(wv->v, wv->peq + wv->t[j] * wv->words, w0, w1,
+                                                              r ? wv->carry[j] : 0);
         }
+        pthread_barrier_wait(&wv->barrier);
     }
-    printf("Length of LCS is: %d\n", L[m * (n + 1) + n]);
-    free(L);
+    return NULL;
 }
 
-/* --- B. Edit Distance (Levenshtein) --- */
-void editDistance(char* str1, char* str2) {
-    int m = strlen(str1);
-    int n = strlen(str2);
-    int i, j;
+/* Same result as lcsLength, computed by 'threads' workers */
+long lcsLengthParallel(const char* a, size_t lenA, const char* b, size_t lenB, int threads) {
+    const unsigned char *p = (const unsigned char*)a, *t = (const unsigned char*)b, *swap;
+    long m = (long)lenA, n = (long)lenB, same, j, result;
+    struct LcsWave wv;
+    struct LcsWaveJob* jobs;
+    pthread_t* tids;
+    EdWord* peq;
+    int k;
 
-    /* Using malloc for 2D array simulation */
-    int *dp = (int*)malloc(sizeof(int) * (m + 1) * (n + 1));
-    
-    if (dp == NULL) { printf("Memory allocation failed\n"); return; }
+    same = lcsTrim(&p, &m, &t, &n);
+    if (m > n) { swap = p; p = t; t = swap; j = m; m = n; n = j; }
+    if (m == 0) return same;
 
-    for (i = 0; i <= m; i++) {
-        for (j = 0; j <= n; j++) {
-            if (i == 0)
-                dp[i * (n + 1) + j] = j; 
-            else if (j == 0)
-                dp[i * (n + 1) + j] = i; 
-            else if (str1[i - 1] == str2[j - 1])
-                dp[i * (n + 1) + j] = dp[(i - 1) * (n + 1) + (j - 1)];
-            else
-                dp[i * (n + 1) + j] = 1 + min3_val(dp[i * (n + 1) + (j - 1)],       /* Insert */
-                                                   dp[(i - 1) * (n + 1) + j],       /* Remove */
-                                                   dp[(i - 1) * (n + 1) + (j - 1)]);/* Replace */
+    wv.t = t;
+    wv.n = n;
+    wv.words = (m + ED_WORD - 1) / ED_WORD;
+    wv.rowBlocks = (wv.words + LCS_TILE_WORDS - 1) / LCS_TILE_WORDS;
+    wv.colChunks = (n + LCS_TILE_COLS - 1) / LCS_TILE_COLS;
+    if (threads < 1) threads = 1;
+    if (threads > wv.rowBlocks) threads = (int)wv.rowBlocks; /* One row block per thread at most */
+    wv.threads = threads;
+    wv.peq = peq = lcsBuildPeq(p, m, 0, wv.words);
+    wv.v = (EdWord*)malloc(sizeof(EdWord) * wv.words);
+    wv.carry = (unsigned char*)malloc(n);
+    tids = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+    jobs = (struct LcsWaveJob*)malloc(sizeof(struct LcsWaveJob) * threads);
+    if (!peq || !wv.v || !wv.carry || !tids || !jobs) {
+        free(peq); free(wv.v); free(wv.carry); free(tids); free(jobs);
+        return -1;
+    }
+    memset(wv.v, 0xff, sizeof(EdWord) * wv.words);
+    pthread_barrier_init(&wv.barrier, NULL, threads);
+
+    for (k = 0; k < threads; k++) {
+        jobs[k].wave = &wv;
+        jobs[k].id = k;
+        pthread_create(&tids[k], NULL, lcsWaveWorker, &jobs[k]);
+    }
+    for (k = 0; k < threads; k++) pthread_join(tids[k], NULL);
+    result = same + lcsCountRows(wv.v, m);
+
+    pthread_barrier_destroy(&wv.barrier);
+    free(peq);
+    free(wv.v);
+    free(wv.carry);
+    free(tids);
+    free(jobs);
+    return result;
+}
+
+/* --- Long-sequence benchmark --- */
+
+/* Random ACGT sequence of length n, and a copy with 'edits' random edits */
+static void makeSequencePair(long n, int edits, char** a, char** b) {
+    unsigned int seed = 2024;
+    long i;
+    *a = (char*)malloc(n + 1);
+    for (i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        (*a)[i] = "ACGT"[(seed >> 16) & 3];
+    }
+    (*a)[n] = '\0';
+    *b = mutateName(*a, &seed, edits);
+}
+
+/* 1 if s[0, k) is a subsequence of t */
+static int isSubsequence(const char* s, size_t k, const char* t) {
+    size_t i = 0;
+    for (; *t && i < k; t++)
+        if (*t == s[i]) i++;
+    return i == k;
+}
+
+void benchmarkLcs(long n, int edits) {
+    static const int threadCounts[] = { 1, 2, 4, 8 };
+    char *a, *b, *lcs, saved[2];
+    long small = 4000, expect, got;
+    size_t len;
+    double start, secs, base;
+    int i, tableLen;
+
+    makeSequencePair(n, edits, &a, &b);
+    printf("\n--- LCS of Two %ld-Byte Sequences (%d edits apart) ---\n", n, edits);
+
+    /* Full table only on a prefix: the whole pair would not fit */
+    saved[0] = a[small]; saved[1] = b[small];
+    a[small] = b[small] = '\0';
+    start = wallSeconds();
+    tableLen = lcsLengthTable(a, b);
+    base = wallSeconds() - start;
+    got = lcsLength(a, small, b, small);
+    printf("%-26s %8.3f s  (%ld x %ld prefix) %s\n", "full table", base, small, small,
+           got == tableLen ? "ok" : "MISMATCH");
+    start = wallSeconds();
+    lcsLength(a, small, b, small);
+    secs = wallSeconds() - start;
+    printf("%-26s %8.3f s  %6.1fx on the prefix\n", "bit-parallel", secs, base / secs);
+    a[small] = saved[0]; b[small] = saved[1];
+
+    /* Edits only every few hundred bytes: prefix/suffix stripping barely helps */
+    start = wallSeconds();
+    expect = lcsLength(a, n, b, strlen(b));
+    secs = wallSeconds() - start;
+    printf("%-26s %8.3f s  LCS = %ld, %.1f Gcells/s\n", "bit-parallel", secs, expect,
+           (double)n * strlen(b) / secs / 1e9);
+
+    start = wallSeconds();
+    lcs = lcsString(a, n, b, strlen(b), &len);
+    secs = wallSeconds() - start;
+    printf("%-26s %8.3f s  %s\n", "Hirschberg (subsequence)", secs,
+           lcs && (long)len == expect && isSubsequence(lcs, len, a) && isSubsequence(lcs, len, b) ? "ok" : "MISMATCH");
+    free(lcs);
+
+    for (i = 0; i < (int)(sizeof(threadCounts) / sizeof(threadCounts[0])); i++) {
+        char label[40];
+        sprintf(label, "wavefront, %d thread%s", threadCounts[i], threadCounts[i] > 1 ? "s" : "");
+        start = wallSeconds();
+        got = lcsLengthParallel(a, n, b, strlen(b), threadCounts[i]);
+        secs = wallSeconds() - start;
+        printf("%-26s %8.3f s  %s\n", label, secs, got == expect ? "ok" : "MISMATCH");
+    }
+    free(a);
+    free(b);
+}
+
+/* ---------------------------------------------------------
+   9. FILE SEARCH (mmap, Streaming, Parallel Chunks)
+   --------------------------------------------------------- */
+
+/* Searches files of any size without loading them into a string first.
+     searchFile   : maps the file read-only with MADV_SEQUENTIAL (the kernel
+                    reads ahead and can drop pages behind the scan) and cuts
+                    it into FILE_CHUNK pieces that worker threads take in
+                    turn. A worker owns the matches that START in its piece
+                    and reads m - 1 bytes past its end, so a match across a
+                    boundary is reported exactly once.
+     SearchStream : the same search fed buffer by buffer, for pipes and
+                    files that cannot be mapped. The last m - 1 bytes are
+                    kept and searched together with the head of the next
+                    buffer.
+   Offsets are absolute byte positions in the file or stream. */
+
+#define FILE_CHUNK ((size_t)16 << 20)
+#define STREAM_BUFFER ((size_t)1 << 20)
+
+/* Shifts offsets by 'base' before calling the user's callback, and drops
+   matches at or past 'limit' (those belong to someone else) */
+struct ShiftedCallback {
+    MatchCallback cb;
+    void* ctx;
+    size_t base, limit, count;
+    int stopped;
+};
+
+static int shiftMatch(size_t offset, void* ctx) {
+    struct ShiftedCallback* sh = (struct ShiftedCallback*)ctx;
+    if (offset >= sh->limit) return 0;
+    sh->count++;
+    if (sh->cb && sh->cb(sh->base + offset, sh->ctx)) {
+        sh->stopped = 1;
+        return 1;
+    }
+    return 0;
+}
+
+struct SearchStream {
+    struct SearchPattern sp;
+    unsigned char* tail;  /* Last m - 1 bytes fed, plus room for m - 1 more */
+    size_t tailLen;
+    size_t consumed;      /* Bytes fed so far */
+};
+
+/* pat must stay valid while the stream is used. Returns 0 if out of memory. */
+int searchStreamInit(struct SearchStream* st, const char* pat, size_t m) {
+    st->tailLen = 0;
+    st->consumed = 0;
+    st->tail = (unsigned char*)malloc(m ? 2 * (m - 1) + 1 : 1);
+    if (st->tail == NULL) return 0;
+    if (!compileSearchPattern(&st->sp, pat, m, SEARCH_AUTO)) {
+        free(st->tail);
+        st->tail = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+void searchStreamFree(struct SearchStream* st) {
+    freeSearchPattern(&st->sp);
+    free(st->tail);
+    st->tail = NULL;
+}
+
+/* Reports matches ending in buf (in increasing order) and returns how many */
+size_t searchStreamFeed(struct SearchStream* st, const char* buf, size_t len, MatchCallback cb, void* ctx) {
+    struct ShiftedCallback sh;
+    size_t keep, head, total;
+
+    if (st->sp.m == 0) return 0;
+    keep = (size_t)st->sp.m - 1;
+    sh.cb = cb;
+    sh.ctx = ctx;
+    sh.count = 0;
+    sh.stopped = 0;
+
+    /* 1. Matches starting in the kept tail. The tail is shorter than the
+          pattern, so each of them ends in buf and was not seen before. */
+    head = len < keep ? len : keep;
+    memcpy(st->tail + st->tailLen, buf, head);
+    if (st->tailLen > 0) {
+        sh.base = st->consumed - st->tailLen;
+        sh.limit = st->tailLen;
+        searchCompiled(&st->sp, (const char*)st->tail, st->tailLen + head, shiftMatch, &sh);
+    }
+
+    /* 2. Matches inside buf */
+    if (!sh.stopped) {
+        sh.base = st->consumed;
+        sh.limit = (size_t)-1;
+        searchCompiled(&st->sp, buf, len, shiftMatch, &sh);
+    }
+
+    /* 3. Keep the last m - 1 bytes of everything fed */
+    if (len >= keep) {
+        memcpy(st->tail, buf + len - keep, keep);
+        st->tailLen = keep;
+    } else {
+        total = st->tailLen + len; /* tail + buf is already in place */
+        if (total > keep) memmove(st->tail, st->tail + total - keep, keep);
+        st->tailLen = total > keep ? keep : total;
+    }
+    st->consumed += len;
+    return sh.count;
+}
+
+/* Streams fd through read() into one buffer of bufSize bytes. The kernel's
+   sequential readahead overlaps the disk with the scan. Returns the number
+   of matches, or (size_t)-1 on a read error or if out of memory. */
+size_t searchFd(int fd, const char* pat, size_t m, size_t bufSize, MatchCallback cb, void* ctx) {
+    struct SearchStream st;
+    char* buf = (char*)malloc(bufSize);
+    size_t count = 0;
+    ssize_t got;
+
+    if (buf == NULL || !searchStreamInit(&st, pat, m)) { free(buf); return (size_t)-1; }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    while ((got = read(fd, buf, bufSize)) != 0) {
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            count = (size_t)-1;
+            break;
         }
+        count += searchStreamFeed(&st, buf, (size_t)got, cb, ctx);
     }
-    printf("Minimum Edit Distance: %d\n", dp[m * (n + 1) + n]);
-    free(dp);
+    searchStreamFree(&st);
+    free(buf);
+    return count;
+}
+
+/* --- Parallel scan of a mapped file --- */
+
+struct FileScan {
+    const struct SearchPattern* sp;
+    const char* data;
+    size_t n, numChunks;
+    size_t next;                /* Next chunk to hand out */
+    struct OffsetList* found;   /* One list per chunk, in file order */
+};
+
+static void* fileChunkWorker(void* arg) {
+    struct FileScan* scan = (struct FileScan*)arg;
+    struct ShiftedCallback sh;
+    size_t c, begin, end, stop;
+
+    while ((c = __sync_fetch_and_add(&scan->next, 1)) < scan->numChunks) {
+        begin = c * FILE_CHUNK;
+        end = (begin + FILE_CHUNK < scan->n) ? begin + FILE_CHUNK : scan->n;
+        stop = (end + scan->sp->m - 1 < scan->n) ? end + scan->sp->m - 1 : scan->n;
+        sh.cb = collectOffset;
+        sh.ctx = &scan->found[c];
+        sh.base = begin;
+        sh.limit = end - begin;
+        sh.count = 0;
+        sh.stopped = 0;
+        searchCompiled(scan->sp, scan->data + begin, stop - begin, shiftMatch, &sh);
+    }
+    return NULL;
+}
+
+/* Calls cb(offset, ctx) for every match in the file, in increasing order.
+   Returns the number of matches, or (size_t)-1 if the file cannot be read.
+   With threads > 1 the callback runs on the calling thread once the scan
+   is done, so returning nonzero stops the reporting, not the scan. */
+size_t searchFile(const char* path, const char* pat, size_t m, int threads, MatchCallback cb, void* ctx) {
+    struct SearchPattern sp;
+    struct FileScan scan;
+    struct stat info;
+    pthread_t* tids;
+    char* data;
+    size_t count = 0, c, k;
+    int fd, t, stopped = 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return (size_t)-1;
+    if (fstat(fd, &info) != 0) { close(fd); return (size_t)-1; }
+    data = (S_ISREG(info.st_mode) && info.st_size > 0)
+               ? (char*)mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
+               : (char*)MAP_FAILED;
+    if (data == (char*)MAP_FAILED) { /* Empty file, pipe, device... */
+        count = searchFd(fd, pat, m, STREAM_BUFFER, cb, ctx);
+        close(fd);
+        return count;
+    }
+    madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+    if (!compileSearchPattern(&sp, pat, m, SEARCH_AUTO)) {
+        munmap(data, (size_t)info.st_size);
+        close(fd);
+        return (size_t)-1;
+    }
+
+    scan.n = (size_t)info.st_size;
+    scan.numChunks = (scan.n + FILE_CHUNK - 1) / FILE_CHUNK;
+    if ((size_t)threads > scan.numChunks) threads = (int)scan.numChunks;
+    if (threads <= 1 || m == 0) {
+        count = searchCompiled(&sp, data, scan.n, cb, ctx);
+    } else {
+        scan.sp = &sp;
+        scan.data = data;
+        scan.next = 0;
+        scan.found = (struct OffsetList*)calloc(scan.numChunks, sizeof(struct OffsetList));
+        tids = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+        if (scan.found == NULL || tids == NULL) {
+            count = (size_t)-1;
+        } else {
+            for (t = 0; t < threads; t++) pthread_create(&tids[t], NULL, fileChunkWorker, &scan);
+            for (t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+            for (c = 0; c < scan.numChunks; c++) {
+                for (k = 0; k < scan.found[c].count && !stopped; k++)
+                    if (cb) stopped = cb(scan.found[c].items[k], ctx);
+                count += scan.found[c].count;
+                free(scan.found[c].items);
+            }
+        }
+        free(scan.found);
+        free(tids);
+    }
+    freeSearchPattern(&sp);
+    munmap(data, (size_t)info.st_size);
+    close(fd);
+    return count;
+}
+
+/* --- File benchmark --- */
+
+static int printFirstMatches(size_t offset, void* ctx) {
+    size_t* shown = (size_t*)ctx;
+    if (*shown < 20) printf("%s%lu", *shown ? ", " : "  ", (unsigned long)offset);
+    (*shown)++;
+    return 0;
+}
+
+static void reportFileScan(const char* label, size_t count, size_t expect, size_t n, double secs) {
+    printf("%-26s %8.2f GB/s %10lu matches%s\n", label, n / secs / 1e9, (unsigned long)count,
+           count == expect ? "" : "  MISMATCH");
+}
+
+/* Writes an n-byte log to path, then searches it in every mode. The file
+   is still in the page cache, so this measures scanning, not the disk. */
+void benchmarkFileSearch(size_t n, const char* path) {
+    static const char* pats[] = { "ERROR", "status=503 latency=1" };
+    static const int threadCounts[] = { 1, 2, 4 };
+    char* txt = makeLogText(n);
+    FILE* fp = fopen(path, "wb");
+    size_t expect, count;
+    double start, secs;
+    char label[40];
+    int p, i, fd;
+
+    if (txt == NULL || fp == NULL || fwrite(txt, 1, n, fp) != n) {
+        printf("Cannot write %s\n", path);
+        if (fp) fclose(fp);
+        free(txt);
+        return;
+    }
+    fclose(fp);
+    free(txt);
+    printf("\n--- File Search (%lu MB file %s) ---\n", (unsigned long)(n >> 20), path);
+
+    for (p = 0; p < (int)(sizeof(pats) / sizeof(pats[0])); p++) {
+        size_t m = strlen(pats[p]);
+        printf("pattern \"%s\"\n", pats[p]);
+
+        /* Baseline: read the whole file into memory, then search */
+        start = wallSeconds();
+        txt = (char*)malloc(n);
+        fp = fopen(path, "rb");
+        if (txt == NULL || fp == NULL || fread(txt, 1, n, fp) != n) {
+            printf("Cannot read %s\n", path);
+            if (fp) fclose(fp);
+            free(txt);
+            break;
+        }
+        fclose(fp);
+        expect = searchAll(txt, n, pats[p], m, NULL, NULL);
+        free(txt);
+        secs = wallSeconds() - start;
+        reportFileScan("  load + search", expect, expect, n, secs);
+
+        /* 64 KB buffers: many chunk boundaries to carry matches across */
+        for (i = 0; i < 2; i++) {
+            size_t bufSize = i ? STREAM_BUFFER : (size_t)64 << 10;
+            fd = open(path, O_RDONLY);
+            start = wallSeconds();
+            count = searchFd(fd, pats[p], m, bufSize, NULL, NULL);
+            secs = wallSeconds() - start;
+            close(fd);
+            sprintf(label, "  read(), %lu KB buffer", (unsigned long)(bufSize >> 10));
+            reportFileScan(label, count, expect, n, secs);
+        }
+
+        for (i = 0; i < (int)(sizeof(threadCounts) / sizeof(threadCounts[0])); i++) {
+            start = wallSeconds();
+            count = searchFile(path, pats[p], m, threadCounts[i], NULL, NULL);
+            secs = wallSeconds() - start;
+            sprintf(label, "  mmap, %d thread%s", threadCounts[i], threadCounts[i] > 1 ? "s" : "");
+            reportFileScan(label, count, expect, n, secs);
+        }
+    }
+    remove(path);
+}
+
+/* ---------------------------------------------------------
+   10. FUZZY INDEX (q-gram Count Filter, Banded Verify)
+   --------------------------------------------------------- */
+
+/* "All dictionary words within distance k of the query" without running
+   the edit distance against every word:
+     length filter : a match has |len(w) - len(query)| <= k. Words are
+                     stored sorted by length, so that is one id range.
+     count filter  : k edits destroy at most k * q of the query's q-grams,
+                     so a match shares at least
+                         max(len(query), len(w)) - q + 1 - k * q
+                     of them (Ukkonen 1992). Each gram has a posting list
+                     of word ids; walking the query's lists inside the id
+                     range counts shared grams per word.
+     verification  : survivors go through editDistanceBounded (band k).
+   Lists are kept for q = FUZZY_MIN_Q..FUZZY_MAX_Q: long grams give short
+   lists but their bound reaches 0 sooner as k grows, so each query takes
+   the longest q that still demands FUZZY_MIN_SHARED grams. With no usable
+   q every word in the length range is verified. Grams are hashed into
+   FUZZY_GRAM_KEYS lists; a collision or a repeated gram only raises the
+   counts, so no match is lost. A query uses scratch space inside the
+   index: one query at a time. */
+
+#define FUZZY_MIN_Q 2
+#define FUZZY_MAX_Q 3
+#define FUZZY_MIN_SHARED 2
+#define FUZZY_GRAM_BITS 16
+#define FUZZY_GRAM_KEYS (1 << FUZZY_GRAM_BITS)
+
+typedef int (*FuzzyCallback)(int wordId, int distance, void* ctx);
+
+struct FuzzyGrams {
+    int* start;     /* Gram key -> range in postings */
+    int* postings;  /* Word ids, increasing within each key */
+};
+
+struct FuzzyIndex {
+    char* pool;             /* All words, NUL-terminated, sorted by length */
+    size_t* start;          /* Word id -> offset in pool, plus the pool size */
+    int count, maxLen;
+    int* lenStart;          /* Ids [lenStart[L], lenStart[L + 1]) have length L */
+    struct FuzzyGrams grams[FUZZY_MAX_Q - FUZZY_MIN_Q + 1];
+    unsigned int* shared;   /* Query scratch: grams shared per word */
+    int* touched;           /* Query scratch: ids with shared > 0 */
+};
+
+static unsigned int fuzzyGramKey(const unsigned char* s, int q) {
+    unsigned int h = 0;
+    int i;
+    for (i = 0; i < q; i++) h = h * 257 + s[i];
+    return (h * 2654435761u) >> (32 - FUZZY_GRAM_BITS);
+}
+
+const char* fuzzyWord(const struct FuzzyIndex* fx, int id) { return fx->pool + fx->start[id]; }
+static size_t fuzzyWordLen(const struct FuzzyIndex* fx, int id) { return fx->start[id + 1] - fx->start[id] - 1; }
+
+void fuzzyFree(struct FuzzyIndex* fx) {
+    int g;
+    if (fx == NULL) return;
+    for (g = 0; g <= FUZZY_MAX_Q - FUZZY_MIN_Q; g++) {
+        free(fx->grams[g].start);
+        free(fx->grams[g].postings);
+    }
+    free(fx->pool);
+    free(fx->start);
+    free(fx->lenStart);
+    free(fx->shared);
+    free(fx->touched);
+    free(fx);
+}
+
+/* Posting lists for one q: count per key, prefix sums, fill in id order */
+static int fuzzyBuildGrams(struct FuzzyIndex* fx, int q, struct FuzzyGrams* gr, int* fill) {
+    size_t total = 0;
+    int id, j, len, i;
+    for (id = 0; id < fx->count; id++)
+        if ((len = (int)fuzzyWordLen(fx, id)) >= q) total += len - q + 1;
+    gr->start = (int*)calloc(FUZZY_GRAM_KEYS + 1, sizeof(int));
+    gr->postings = (int*)malloc(sizeof(int) * (total ? total : 1));
+    if (!gr->start || !gr->postings) return 0;
+
+    for (id = 0; id < fx->count; id++) {
+        const unsigned char* w = (const unsigned char*)fuzzyWord(fx, id);
+        for (len = (int)fuzzyWordLen(fx, id), j = 0; j + q <= len; j++) gr->start[fuzzyGramKey(w + j, q) + 1]++;
+    }
+    for (i = 0; i < FUZZY_GRAM_KEYS; i++) gr->start[i + 1] += gr->start[i];
+    memcpy(fill, gr->start, sizeof(int) * FUZZY_GRAM_KEYS);
+    for (id = 0; id < fx->count; id++) {
+        const unsigned char* w = (const unsigned char*)fuzzyWord(fx, id);
+        for (len = (int)fuzzyWordLen(fx, id), j = 0; j + q <= len; j++) gr->postings[fill[fuzzyGramKey(w + j, q)]++] = id;
+    }
+    return 1;
+}
+
+/* Bulk build: counting sorts by length and by gram key, so posting lists
+   come out sorted with no per-word inserts. Word ids refer to the index's
+   own (length) order; see fuzzyWord. */
+struct FuzzyIndex* fuzzyBuild(const char* const* words, int count) {
+    struct FuzzyIndex* fx = (struct FuzzyIndex*)calloc(1, sizeof(struct FuzzyIndex));
+    size_t* lens;
+    size_t poolSize = 0, pos;
+    int i, id, len, g, ok, *fill;
+
+    if (fx == NULL) return NULL;
+    fx->count = count;
+    lens = (size_t*)malloc(sizeof(size_t) * (count ? count : 1));
+    if (lens == NULL) { free(fx); return NULL; }
+    for (i = 0; i < count; i++) {
+        lens[i] = strlen(words[i]);
+        poolSize += lens[i] + 1;
+        if ((int)lens[i] > fx->maxLen) fx->maxLen = (int)lens[i];
+    }
+
+    fx->pool = (char*)malloc(poolSize ? poolSize : 1);
+    fx->start = (size_t*)malloc(sizeof(size_t) * (count + 1));
+    fx->lenStart = (int*)calloc(fx->maxLen + 2, sizeof(int));
+    fx->shared = (unsigned int*)calloc(count ? count : 1, sizeof(unsigned int));
+    fx->touched = (int*)malloc(sizeof(int) * (count ? count : 1));
+    fill = (int*)malloc(sizeof(int) * (fx->maxLen + 2 > FUZZY_GRAM_KEYS ? fx->maxLen + 2 : FUZZY_GRAM_KEYS));
+    ok = fx->pool && fx->start && fx->lenStart && fx->shared && fx->touched && fill;
+
+    if (ok) {
+        /* Counting sort by length: id order = length order */
+        for (i = 0; i < count; i++) fx->lenStart[lens[i] + 1]++;
+        for (len = 0; len <= fx->maxLen; len++) fx->lenStart[len + 1] += fx->lenStart[len];
+        memcpy(fill, fx->lenStart, sizeof(int) * (fx->maxLen + 1));
+        for (i = 0; i < count; i++) fx->touched[fill[lens[i]]++] = i; /* touched: id -> input index */
+        for (pos = 0, id = 0; id < count; id++) {
+            i = fx->touched[id];
+            fx->start[id] = pos;
+            memcpy(fx->pool + pos, words[i], lens[i] + 1);
+            pos += lens[i] + 1;
+        }
+        fx->start[count] = pos;
+        for (g = 0; ok && g <= FUZZY_MAX_Q - FUZZY_MIN_Q; g++) ok = fuzzyBuildGrams(fx, FUZZY_MIN_Q + g, &fx->grams[g], fill);
+    }
+    free(lens);
+    free(fill);
+    if (!ok) { fuzzyFree(fx); return NULL; }
+    return fx;
+}
+
+/* First position in list[0, n) holding an id >= id */
+static int fuzzyLowerBound(const int* list, int n, int id) {
+    int lo = 0, hi = n, mid;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (list[mid] < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* Calls cb(id, distance, ctx) for every word within distance k, in no
+   particular order; a nonzero return stops the reporting. Returns the
+   number of matches reported. */
+size_t fuzzySearch(struct FuzzyIndex* fx, const char* query, size_t queryLen, int k, FuzzyCallback cb, void* ctx) {
+    const unsigned char* qs = (const unsigned char*)query;
+    const struct FuzzyGrams* gr;
+    int L = (int)queryLen, q, shortest, longest, lo, hi, id, i, j, end, numTouched = 0;
+    int need, dist, wordLen, stopped = 0;
+    size_t found = 0;
+
+    shortest = L - k > 0 ? L - k : 0;
+    longest = L + k < fx->maxLen ? L + k : fx->maxLen;
+    if (k < 0 || shortest > longest) return 0;
+    lo = fx->lenStart[shortest];
+    hi = fx->lenStart[longest + 1];
+
+    /* Longest gram that still has to survive FUZZY_MIN_SHARED times */
+    for (q = FUZZY_MAX_Q; q > FUZZY_MIN_Q && L - q + 1 - k * q < FUZZY_MIN_SHARED; q--) ;
+    if (L - q + 1 - k * q <= 0) {
+        /* No gram has to survive: verify the whole length range */
+        for (id = lo; id < hi && !stopped; id++) {
+            dist = editDistanceBounded(query, queryLen, fuzzyWord(fx, id), fuzzyWordLen(fx, id), k);
+            if (dist >= 0) {
+                found++;
+                if (cb) stopped = cb(id, dist, ctx);
+            }
+        }
+        return found;
+    }
+
+    gr = &fx->grams[q - FUZZY_MIN_Q];
+    for (j = 0; j + q <= L; j++) {
+        unsigned int key = fuzzyGramKey(qs + j, q);
+        const int* list = gr->postings + gr->start[key];
+        end = gr->start[key + 1] - gr->start[key];
+        for (i = fuzzyLowerBound(list, end, lo); i < end && list[i] < hi; i++)
+            if (fx->shared[list[i]]++ == 0) fx->touched[numTouched++] = list[i];
+    }
+
+    for (i = 0; i < numTouched; i++) {
+        id = fx->touched[i];
+        wordLen = (int)fuzzyWordLen(fx, id);
+        need = (L > wordLen ? L : wordLen) - q + 1 - k * q;
+        if (!stopped && (int)fx->shared[id] >= need) {
+            dist = editDistanceBounded(query, queryLen, fuzzyWord(fx, id), (size_t)wordLen, k);
+            if (dist >= 0) {
+                found++;
+                if (cb) stopped = cb(id, dist, ctx);
+            }
+        }
+        fx->shared[id] = 0; /* Scratch must be clean for the next query */
+    }
+    return found;
+}
+
+static int printFuzzyMatch(int wordId, int distance, void* ctx) {
+    printf("\"%s\" (distance %d)\n", fuzzyWord((const struct FuzzyIndex*)ctx, wordId), distance);
+    return 0;
+}
+
+/* --- Dictionary benchmark --- */
+
+/* Pronounceable word of 3-5 syllables: a real dictionary has many more
+   near neighbours than uniformly random strings */
+static char* randomWord(unsigned int* seed) {
+    static const char* onsets = "bcdfghklmnprstvz";
+    static const char* vowels = "aeiou";
+    char* s = (char*)malloc(16);
+    int parts, i, len = 0;
+    *seed = *seed * 1103515245u + 12345u;
+    parts = 3 + (int)((*seed >> 16) % 3);
+    for (i = 0; i < parts; i++) {
+        *seed = *seed * 1103515245u + 12345u;
+        s[len++] = onsets[(*seed >> 12) % 16];
+        s[len++] = vowels[(*seed >> 20) % 5];
+        if ((*seed >> 28) % 4 == 0) s[len++] = onsets[(*seed >> 4) % 16]; /* Closed syllable */
+    }
+    s[len] = '\0';
+    return s;
+}
+
+static int countFuzzyMatch(int wordId, int distance, void* ctx) {
+    (void)wordId;
+    (void)distance;
+    (*(size_t*)ctx)++;
+    return 0;
+}
+
+void benchmarkFuzzyIndex(int numWords, int numQueries) {
+    char** words = (char**)malloc(sizeof(char*) * numWords);
+    char** queries = (char**)malloc(sizeof(char*) * numQueries);
+    struct FuzzyIndex* fx;
+    unsigned int seed = 99;
+    size_t found, expect;
+    double start, secs, brute;
+    int i, w, k, bad, bruteQueries = 20;
+
+    for (i = 0; i < numWords; i++) words[i] = randomWord(&seed);
+    for (i = 0; i < numQueries; i++) { /* Dictionary words with 0-2 typos */
+        seed = seed * 1103515245u + 12345u;
+        queries[i] = mutateName(words[(seed >> 8) % numWords], &seed, (int)((seed >> 28) % 3));
+    }
+
+    start = wallSeconds();
+    fx = fuzzyBuild((const char* const*)words, numWords);
+    secs = wallSeconds() - start;
+    if (fx == NULL) { printf("Memory allocation failed\n"); return; }
+    printf("\n--- Fuzzy Lookup, %d-Word Dictionary ---\n", numWords);
+    printf("bulk build %.2f s\n", secs);
+
+    for (k = 1; k <= 2; k++) {
+        /* Brute force: banded distance to every word, few queries only */
+        start = wallSeconds();
+        for (expect = 0, i = 0; i < bruteQueries; i++)
+            for (w = 0; w < numWords; w++)
+                if (editDistanceBounded(queries[i], strlen(queries[i]), words[w], strlen(words[w]), k) >= 0) expect++;
+        brute = (wallSeconds() - start) / bruteQueries;
+        printf("k = %d  %-22s %10.0f queries/s\n", k, "brute force (banded)", 1 / brute);
+
+        for (found = 0, i = 0; i < bruteQueries; i++)
+            fuzzySearch(fx, queries[i], strlen(queries[i]), k, countFuzzyMatch, &found);
+        bad = found != expect;
+
+        start = wallSeconds();
+        for (found = 0, i = 0; i < numQueries; i++)
+            fuzzySearch(fx, queries[i], strlen(queries[i]), k, countFuzzyMatch, &found);
+        secs = (wallSeconds() - start) / numQueries;
+        printf("       %-22s %10.0f queries/s %7.0fx %s (%.1f matches/query)\n", "q-gram index", 1 / secs,
+               brute / secs, bad ? "MISMATCH" : "ok", (double)found / numQueries);
+    }
+    fuzzyFree(fx);
+    for (i = 0; i < numWords; i++) free(words[i]);
+    for (i = 0; i < numQueries; i++) free(queries[i]);
+    free(words);
+    free(queries);
 }
 
 /* ---------------------------------------------------------
@@ -240,6 +2907,19 @@ int main() {
         printf("5. Rabin-Karp Pattern Search\n");
         printf("6. Longest Common Subsequence (LCS)\n");
         printf("7. Edit Distance (Levenshtein)\n");
+        printf("8. Find All Occurrences (offsets)\n");
+        printf("9. Benchmark: Search Throughput\n");
+        printf("10. Multi-Pattern Search (Aho-Corasick)\n");
+        printf("11. Benchmark: 10,000 Keywords (Aho-Corasick)\n");
+        printf("12. Suffix Array: Occurrences + Longest Repeat\n");
+        printf("13. Benchmark: Suffix Index vs Rescanning (%s)\n", INDEX_FILE);
+        printf("14. Edit Distance Within k (banded)\n");
+        printf("15. Benchmark: Edit Distance Engines (1M name pairs)\n");
+        printf("16. Benchmark: LCS of Two 256 KB Sequences\n");
+        printf("17. Search a File (all offsets)\n");
+        printf("18. Benchmark: File Search, mmap vs read() (%s)\n", SEARCH_BENCH_FILE);
+        printf("19. Fuzzy Lookup (words within k)\n");
+        printf("20. Benchmark: Fuzzy Index vs Brute Force (1M words)\n");
         printf("0. Exit\n");
         printf("----------------------------------------\n");
         printf("Enter your choice: ");
@@ -312,6 +2992,144 @@ int main() {
                 }
             }
             break;
+        case 8:
+            printf("Enter Text: ");
+            if (fgets(str1, MAX, stdin)) {
+                cleanInput(str1);
+                printf("Enter Pattern: ");
+                if (fgets(str2, MAX, stdin)) {
+                    size_t count, k;
+                    size_t* offsets;
+                    cleanInput(str2);
+                    offsets = searchAllOffsets(str1, strlen(str1), str2, strlen(str2), &count);
+                    printf("%lu match(es)", (unsigned long)count);
+                    for (k = 0; k < count; k++) printf("%s%lu", k ? ", " : ": ", (unsigned long)offsets[k]);
+                    printf("\n");
+                    free(offsets);
+                }
+            }
+            break;
+        case 9:
+            benchmarkSearch((size_t)256 << 20);
+            break;
+        case 10:
+            printf("Enter Text: ");
+            if (fgets(str1, MAX, stdin)) {
+                cleanInput(str1);
+                printf("Enter Patterns (space separated): ");
+                if (fgets(str2, MAX, stdin)) {
+                    const char* words[MAX / 2];
+                    struct AhoCorasick* ac;
+                    struct AcMatch* found;
+                    size_t count, k;
+                    int numWords = 0;
+                    char* tok;
+                    cleanInput(str2);
+                    for (tok = strtok(str2, " "); tok != NULL && numWords < MAX / 2; tok = strtok(NULL, " "))
+                        words[numWords++] = tok;
+                    ac = acBuild(words, numWords);
+                    count = acSearchParallel(ac, str1, strlen(str1), 1, &found);
+                    for (k = 0; k < count; k++)
+                        printf("\"%s\" at index %lu\n", words[found[k].patternId], (unsigned long)found[k].offset);
+                    if (count == 0) printf("No pattern found.\n");
+                    free(found);
+                    acFree(ac);
+                }
+            }
+            break;
+        case 11:
+            benchmarkAhoCorasick((size_t)256 << 20, 10000);
+            break;
+        case 12:
+            printf("Enter Text: ");
+            if (fgets(str1, MAX, stdin)) {
+                cleanInput(str1);
+                printf("Enter Pattern: ");
+                if (fgets(str2, MAX, stdin)) {
+                    struct SuffixIndex* idx = buildSuffixIndex(str1, strlen(str1));
+                    SaIndex first, count, pos, len, k;
+                    cleanInput(str2);
+                    if (idx == NULL) { printf("Memory allocation failed\n"); break; }
+                    count = suffixRange(idx, str2, strlen(str2), &first);
+                    printf("%ld occurrence(s), suffix array order:", (long)count);
+                    for (k = 0; k < count; k++) printf(" %ld", (long)idx->sa[first + k]);
+                    len = longestRepeatedSubstring(idx, &pos);
+                    printf("\nLongest repeated substring: \"%.*s\" (length %ld)\n", (int)len, str1 + pos, (long)len);
+                    freeSuffixIndex(idx);
+                }
+            }
+            break;
+        case 13:
+            benchmarkSuffixIndex((size_t)16 << 20, 100000, INDEX_FILE);
+            break;
+        case 14:
+            printf("Enter Source String: ");
+            if (fgets(str1, MAX, stdin)) {
+                cleanInput(str1);
+                printf("Enter Target String: ");
+                if (fgets(str2, MAX, stdin)) {
+                    int k, result;
+                    cleanInput(str2);
+                    printf("Enter k: ");
+                    if (scanf("%d", &k) != 1) k = 0;
+                    getchar();
+                    result = editDistanceBounded(str1, strlen(str1), str2, strlen(str2), k);
+                    printf("Bit-parallel distance: %d\n", editDistanceFast(str1, strlen(str1), str2, strlen(str2)));
+                    if (result >= 0) printf("Within k: distance %d\n", result);
+                    else printf("Distance is greater than %d\n", k);
+                }
+            }
+            break;
+        case 15:
+            benchmarkEditDistance(1000000);
+            break;
+        case 16:
+            benchmarkLcs(256L << 10, 2500);
+            break;
+        case 17:
+            printf("Enter File Path: ");
+            if (fgets(str1, MAX, stdin)) {
+                cleanInput(str1);
+                printf("Enter Pattern: ");
+                if (fgets(str2, MAX, stdin)) {
+                    size_t count, shown = 0;
+                    cleanInput(str2);
+                    count = searchFile(str1, str2, strlen(str2), 4, printFirstMatches, &shown);
+                    if (count == (size_t)-1) printf("Cannot read %s\n", str1);
+                    else printf("%s%lu match(es)\n", shown ? "\n" : "", (unsigned long)count);
+                }
+            }
+            break;
+        case 18:
+            benchmarkFileSearch((size_t)512 << 20, SEARCH_BENCH_FILE);
+            break;
+        case 19:
+            printf("Enter Dictionary Words (space separated): ");
+            if (fgets(str1, MAX, stdin)) {
+                cleanInput(str1);
+                printf("Enter Query: ");
+                if (fgets(str2, MAX, stdin)) {
+                    const char* words[MAX / 2];
+                    struct FuzzyIndex* fx;
+                    int numWords = 0, k;
+                    char* tok;
+                    cleanInput(str2);
+                    printf("Enter k: ");
+                    if (scanf("%d", &k) != 1) k = 0;
+                    getchar();
+                    for (tok = strtok(str1, " "); tok != NULL && numWords < MAX / 2; tok = strtok(NULL, " "))
+                        words[numWords++] = tok;
+                    fx = fuzzyBuild(words, numWords);
+                    if (fx == NULL) { printf("Memory allocation failed\n"); break; }
+                    if (fuzzySearch(fx, str2, strlen(str2), k, printFuzzyMatch, fx) == 0)
+                        printf("No word within distance %d.\n", k);
+                    fuzzyFree(fx);
+                }
+            }
+            break;
+        case 20:
+            benchmarkFuzzyIndex(1000000, 20000);
+            break;
         default:
             printf("Invalid choice! Please try again.\n");
         }
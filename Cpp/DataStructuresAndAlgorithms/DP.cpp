@@ -2,10 +2,85 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <climits>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include "MEMOIZE.h"
+#if defined(__AVX2__)
+#include <immintrin.h> // Knapsack: max over the weight axis
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
 
 using namespace std;
 
+// =================================================================
+// ONLINE LIS (Patience Sorting)
+// Elements arrive one at a time; length() and sequence() always describe
+// the longest increasing subsequence of everything pushed so far.
+// tails[k] = smallest value that ends an increasing run of length k+1.
+// tails is sorted, so each push is one binary search: O(log n).
+// =================================================================
+class StreamingLIS {
+public:
+    // nonDecreasing: equal neighbours allowed (2, 2, 3 counts as length 3)
+    explicit StreamingLIS(bool nonDecreasing = false) : nonDecreasing(nonDecreasing) {}
+
+    void reserve(size_t n) {
+        values.reserve(n);
+        prev.reserve(n);
+    }
+
+    // Returns the length of the longest subsequence ending at x
+    int push(int x) {
+        // Strict: replace the first tail >= x. Non-decreasing: first tail > x.
+        auto it = nonDecreasing ? upper_bound(tails.begin(), tails.end(), x)
+                                : lower_bound(tails.begin(), tails.end(), x);
+        size_t pile = it - tails.begin();
+        int index = (int)values.size();
+
+        // Predecessor link: whatever ended the run one shorter, right now
+        prev.push_back(pile ? tailIndex[pile - 1] : -1);
+        values.push_back(x);
+        if (it == tails.end()) {
+            tails.push_back(x);
+            tailIndex.push_back(index);
+        } else {
+            *it = x;
+            tailIndex[pile] = index;
+        }
+        return (int)pile + 1;
+    }
+
+    size_t length() const { return tails.size(); }
+
+    // Positions (in push order) of one longest subsequence
+    vector<int> indices() const {
+        vector<int> path(tails.size());
+        int at = tails.empty() ? -1 : tailIndex.back();
+        for (size_t k = path.size(); k-- > 0; at = prev[at]) path[k] = at;
+        return path;
+    }
+
+    vector<int> sequence() const {
+        vector<int> seq;
+        for (int i : indices()) seq.push_back(values[i]);
+        return seq;
+    }
+
+private:
+    bool nonDecreasing;
+    vector<int> tails;
+    vector<int> tailIndex; // Position of tails[k] in values
+    vector<int> prev;      // Predecessor position of every element, -1 = none
+    vector<int> values;
+};
+
 class DPMaster {
 public:
     // =================================================================
@@ -21,14 +96,18 @@ public:
     }
 
     // 1.2 Top-Down: Recursion + Memoization (O(n) Time, O(n) Space)
-    int climbMemoization(int n, vector<int>& memo) {
-        if (n == 0 || n == 1) return 1;
-        
-        // CHECK: Have we solved this state before?
-        if (memo[n] != -1) return memo[n];
-
-        // STORE: Save result before returning
-        return memo[n] = climbMemoization(n - 1, memo) + climbMemoization(n - 2, memo);
+    // The cache (MEMOIZE.h) is a dense array indexed by n. Every call to
+    // `self` checks it first (have we solved this state before?) and
+    // stores the result on the way out.
+    int climbMemoization(int n, MemoStats* stats = nullptr) {
+        if (n < 0) return 0;
+        auto climb = memoizeDense<int(int)>([](auto& self, int i) -> int {
+            if (i == 0 || i == 1) return 1;
+            return self(i - 1) + self(i - 2);
+        }, n + 1);
+        int ways = climb(n);
+        if (stats) *stats = climb.stats();
+        return ways;
     }
 
     // 1.3 Bottom-Up: Tabulation (O(n) Time, O(n) Space)
@@ -62,12 +141,29 @@ public:
         return prev1;
     }
 
+    // 1.5 Two-Dimensional State: monotone paths through a grid (mod 1e9+7)
+    // The argument tuple (r, c) is the key; both are bounded, so the cache
+    // is a dense (rows + 1) x (cols + 1) array.
+    long long gridPaths(int rows, int cols, MemoStats* stats = nullptr) {
+        if (rows < 0 || cols < 0) return 0;
+        auto paths = memoizeDense<long long(int, int)>([](auto& self, int r, int c) -> long long {
+            if (r == 0 || c == 0) return 1;
+            return (self(r - 1, c) + self(r, c - 1)) % 1000000007;
+        }, rows + 1, cols + 1);
+        long long count = paths(rows, cols);
+        if (stats) *stats = paths.stats();
+        return count;
+    }
+
     // =================================================================
     // LEVEL 2: THE KNAPSACK PATTERN (0/1 Knapsack)
     // Problem: Maximize value with weight limit W.
     // Logic: For every item, we have a CHOICE: Include it OR Exclude it.
     // =================================================================
-    int knapsack(int W, const vector<int>& weights, const vector<int>& values) {
+
+    // 2.1 Tabulation (O(n*W) Time, O(n*W) Space)
+    // Fine for the textbook sizes; at W ~ 1e7 the table is gigabytes.
+    int knapsackTable(int W, const vector<int>& weights, const vector<int>& values) {
         int n = weights.size();
         // dp[i][w] = Max value using first 'i' items with weight limit 'w'
         vector<vector<int>> dp(n + 1, vector<int>(W + 1, 0));
@@ -91,12 +187,64 @@ public:
         return dp[n][W];
     }
 
+    // 2.2 Space Optimization (O(n*W) Time, O(W) Space)
+    // Row i only reads row i-1, so one row is updated in place. Going from
+    // w = W down means dp[w - weight] still holds the previous row's value
+    // (each item used at most once).
+    int knapsack(int W, const vector<int>& weights, const vector<int>& values) {
+        if (W < 0) return 0;
+        vector<int> dp(W + 1, 0);
+        for (size_t i = 0; i < weights.size(); i++) addItem(dp.data(), W, weights[i], values[i]);
+        return dp[W];
+    }
+
+    // 2.3 Subset Sum Feasibility (O(n*W/64) Time, O(W/64) Space)
+    // reach bit s = "some subset weighs exactly s". Adding an item shifts
+    // the whole set by its weight and ORs it in: 64 sums per instruction.
+    vector<uint64_t> reachableSums(int W, const vector<int>& weights) {
+        size_t words = W / 64 + 1;
+        vector<uint64_t> reach(words, 0);
+        reach[0] = 1; // Empty subset
+        for (int weight : weights) {
+            if (weight < 0 || weight > W) continue;
+            size_t shiftWords = weight / 64, shiftBits = weight % 64;
+            // High words first: the sources (lower words) are still unshifted
+            for (size_t i = words; i-- > shiftWords;) {
+                uint64_t moved = reach[i - shiftWords] << shiftBits;
+                if (shiftBits && i > shiftWords) moved |= reach[i - shiftWords - 1] >> (64 - shiftBits);
+                reach[i] |= moved;
+            }
+        }
+        if ((W + 1) % 64) reach.back() &= (1ULL << ((W + 1) % 64)) - 1; // Drop sums above W
+        return reach;
+    }
+
+    bool canReachSum(int target, const vector<int>& weights) {
+        if (target < 0) return false;
+        vector<uint64_t> reach = reachableSums(target, weights);
+        return (reach[target / 64] >> (target % 64)) & 1;
+    }
+
+    // 2.4 Reconstruction in O(W) Space (divide and conquer, Hirschberg style)
+    // A 1D row forgets which items were taken. Split the items in half: the
+    // best split of the capacity maximizes front[c] + back[W - c], where
+    // each side is a 2.2 row over its half. Recurse on both halves.
+    // Every level costs one pass over all items, so ~2x the work of 2.2.
+    vector<int> knapsackItems(int W, const vector<int>& weights, const vector<int>& values) {
+        vector<int> chosen;
+        if (W >= 0) pickItems(W, weights, values, 0, weights.size(), chosen);
+        return chosen; // Item indices, increasing
+    }
+
     // =================================================================
     // LEVEL 3: STRING DP (Longest Common Subsequence)
     // Problem: Find length of longest subsequence common to Text1 and Text2.
     // Logic: If chars match, 1 + diagonal. If not, max(left, up).
     // =================================================================
-    int longestCommonSubsequence(string text1, string text2) {
+
+    // 3.1 Tabulation (O(n*m) Time, O(n*m) Space)
+    // string_view: the caller's strings are read in place, never copied.
+    int longestCommonSubsequence(string_view text1, string_view text2) {
         int n = text1.size();
         int m = text2.size();
         
@@ -118,12 +266,63 @@ public:
         return dp[n][m];
     }
 
+    // 3.2 Space Optimization (O(n*m) Time, O(min(n,m)) Space)
+    // Row i only reads row i-1, so one row plus the saved diagonal is enough.
+    int lcsSpaceOpt(string_view text1, string_view text2) {
+        if (text1.size() < text2.size()) swap(text1, text2); // Row = shorter string
+        vector<int> row(text2.size() + 1, 0);
+
+        for (char c : text1) {
+            int diagonal = 0; // dp[i-1][j-1]
+            for (size_t j = 1; j <= text2.size(); j++) {
+                int up = row[j];
+                row[j] = (c == text2[j - 1]) ? diagonal + 1 : max(up, row[j - 1]);
+                diagonal = up;
+            }
+        }
+        return row.back();
+    }
+
+    // 3.3 Bit-Parallel (O(n*m/64) Time, O(m) Space) - Allison-Dix / Hyyro
+    // One bit per character of text2: bit i is 0 where the LCS grows at row i.
+    // A whole column of the table is updated with AND, ADD and OR on 64-bit
+    // words, the ADD carrying between words. LCS = number of 0 bits.
+    int lcsBitParallel(string_view text1, string_view text2) {
+        if (text1.size() < text2.size()) swap(text1, text2);
+        size_t m = text2.size(), words = (m + 63) / 64;
+        if (m == 0) return 0;
+
+        // match[c] = bits of the positions where text2 has character c
+        vector<uint64_t> match(256 * words, 0);
+        for (size_t i = 0; i < m; i++)
+            match[(unsigned char)text2[i] * words + i / 64] |= 1ULL << (i % 64);
+
+        vector<uint64_t> v(words, ~0ULL);
+        for (char c : text1) {
+            const uint64_t* eq = &match[(unsigned char)c * words];
+            uint64_t carry = 0;
+            for (size_t w = 0; w < words; w++) {
+                uint64_t u = v[w] & eq[w];
+                uint64_t sum = v[w] + u + carry;
+                carry = (sum < u) || (carry && sum == u); // Carry out of this word
+                v[w] = sum | (v[w] & ~u);
+            }
+        }
+
+        if (m % 64) v[words - 1] |= ~0ULL << (m % 64); // Ignore padding rows above m
+        int zeros = 0;
+        for (uint64_t w : v) zeros += 64 - __builtin_popcountll(w);
+        return zeros;
+    }
+
     // =================================================================
     // LEVEL 4: LINEAR DP (Longest Increasing Subsequence)
     // Problem: Find the length of the longest subsequence that is strictly increasing.
     // Logic: Compare current number with all previous numbers.
     // =================================================================
-    int lengthOfLIS(const vector<int>& nums) {
+
+    // 4.1 Quadratic DP (O(n^2) Time, O(n) Space) - minutes at n = 1e6
+    int lengthOfLISQuadratic(const vector<int>& nums) {
         if (nums.empty()) return 0;
         int n = nums.size();
         
@@ -144,6 +343,73 @@ public:
         }
         return max_len;
     }
+
+    // 4.2 Patience Sorting (O(n log n) Time, O(n) Space)
+    // Only the smallest tail per length matters: a smaller tail can be
+    // extended by everything a larger one can. Binary search finds the pile.
+    int lengthOfLIS(const vector<int>& nums) {
+        vector<int> tails;
+        for (int x : nums) {
+            auto it = lower_bound(tails.begin(), tails.end(), x);
+            if (it == tails.end()) tails.push_back(x);
+            else *it = x;
+        }
+        return tails.size();
+    }
+
+    // 4.3 Reconstruction: the subsequence itself, via predecessor links.
+    // nonDecreasing = true gives the longest non-decreasing subsequence.
+    vector<int> longestIncreasingSubsequence(const vector<int>& nums, bool nonDecreasing = false) {
+        StreamingLIS lis(nonDecreasing);
+        lis.reserve(nums.size());
+        for (int x : nums) lis.push(x);
+        return lis.sequence();
+    }
+
+private:
+    // dp[w] = max(dp[w], dp[w - weight] + value) for w = W..weight, downward.
+    // A block of lanes loads its dp[w - weight] sources before storing, and
+    // everything above the block is already final, so vectors are safe.
+    static void addItem(int* dp, int W, int weight, int value) {
+        if (weight < 0) return;
+        int w = W;
+#if defined(__AVX2__)
+        __m256i add = _mm256_set1_epi32(value);
+        for (; w - 7 >= weight; w -= 8) {
+            __m256i take = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(dp + w - 7 - weight)), add);
+            __m256i keep = _mm256_loadu_si256((const __m256i*)(dp + w - 7));
+            _mm256_storeu_si256((__m256i*)(dp + w - 7), _mm256_max_epi32(keep, take));
+        }
+#elif defined(__SSE4_1__)
+        __m128i add = _mm_set1_epi32(value);
+        for (; w - 3 >= weight; w -= 4) {
+            __m128i take = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(dp + w - 3 - weight)), add);
+            __m128i keep = _mm_loadu_si128((const __m128i*)(dp + w - 3));
+            _mm_storeu_si128((__m128i*)(dp + w - 3), _mm_max_epi32(keep, take));
+        }
+#endif
+        for (; w >= weight; w--) dp[w] = max(dp[w], dp[w - weight] + value);
+    }
+
+    void pickItems(int W, const vector<int>& weights, const vector<int>& values,
+                   size_t first, size_t last, vector<int>& chosen) {
+        if (last - first == 1) {
+            if (weights[first] >= 0 && weights[first] <= W && values[first] > 0) chosen.push_back((int)first);
+            return;
+        }
+        if (last == first) return;
+        size_t mid = first + (last - first) / 2;
+        int split = 0;
+        {
+            vector<int> front(W + 1, 0), back(W + 1, 0);
+            for (size_t i = first; i < mid; i++) addItem(front.data(), W, weights[i], values[i]);
+            for (size_t i = mid; i < last; i++) addItem(back.data(), W, weights[i], values[i]);
+            for (int c = 0; c <= W; c++)
+                if (front[c] + back[W - c] > front[split] + back[W - split]) split = c;
+        } // Rows freed before recursing: O(W) live at any depth
+        pickItems(split, weights, values, first, mid, chosen);
+        pickItems(W - split, weights, values, mid, last, chosen);
+    }
 };
 
 int main() {
@@ -151,13 +417,71 @@ int main() {
 
     // --- TEST 1: The Evolution (Climbing Stairs) ---
     int steps = 10;
-    vector<int> memo(steps + 1, -1);
+    MemoStats climbStats;
     cout << "--- 1. DP Evolution (Climbing 10 stairs) ---" << endl;
     cout << "Recursive: " << solver.climbRecursive(steps) << endl;
-    cout << "Memoized:  " << solver.climbMemoization(steps, memo) << endl;
+    cout << "Memoized:  " << solver.climbMemoization(steps, &climbStats)
+         << " (" << climbStats.misses << " misses, " << climbStats.hits << " hits)" << endl;
     cout << "Tabulated: " << solver.climbTabulation(steps) << endl;
     cout << "Optimized: " << solver.climbSpaceOpt(steps) << endl;
 
+    // --- TEST 1b: Memoize facility on a 2000 x 2000 grid (4M states) ---
+    {
+        int n = 2000;
+        MemoStats gridStats;
+        auto start = chrono::steady_clock::now();
+        long long dense = solver.gridPaths(n, n, &gridStats);
+        double denseSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // Same recursion on the general (flat hash map) store. MemoHash keeps
+        // 4 x 4 tiles of neighbouring states in one 16-slot group, so this runs
+        // about level with the hand-rolled unordered_map below; the dense store
+        // above is still the fastest when the argument ranges are known.
+        auto hashed = memoize<long long(int, int)>([](auto& self, int r, int c) -> long long {
+            if (r == 0 || c == 0) return 1;
+            return (self(r - 1, c) + self(r, c - 1)) % 1000000007;
+        }, size_t(n + 1) * (n + 1));
+        start = chrono::steady_clock::now();
+        long long viaHash = hashed(n, n);
+        double hashSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // The hand-rolled way: std::function recursion + unordered_map
+        unordered_map<long long, long long> table;
+        function<long long(int, int)> slow = [&](int r, int c) -> long long {
+            if (r == 0 || c == 0) return 1;
+            long long key = (long long)r << 32 | c;
+            auto it = table.find(key);
+            if (it != table.end()) return it->second;
+            long long v = (slow(r - 1, c) + slow(r, c - 1)) % 1000000007;
+            return table[key] = v;
+        };
+        start = chrono::steady_clock::now();
+        long long reference = slow(n, n);
+        double slowSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // Sharded cache shared by 4 threads working on overlapping grids
+        auto shared = memoizeSharded<long long(int, int)>([](auto& self, int r, int c) -> long long {
+            if (r == 0 || c == 0) return 1;
+            return (self(r - 1, c) + self(r, c - 1)) % 1000000007;
+        });
+        vector<thread> workers;
+        vector<long long> results(4);
+        start = chrono::steady_clock::now();
+        for (int t = 0; t < 4; t++)
+            workers.emplace_back([&, t] { results[t] = shared(n - t * 100, n); });
+        for (thread& w : workers) w.join();
+        double sharedSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        MemoStats sharedStats = shared.stats();
+
+        cout << "\n--- 1b. Memoized Grid Paths (" << n << " x " << n << ", mod 1e9+7) ---" << endl;
+        cout << "Dense memoize:               " << dense << (dense == reference ? " (ok)" : " (MISMATCH)") << " in " << denseSecs
+             << " s, " << gridStats.misses << " misses, " << gridStats.hits << " hits" << endl;
+        cout << "Flat hash memoize:           " << (viaHash == reference ? "ok" : "MISMATCH") << " in " << hashSecs << " s" << endl;
+        cout << "std::function+unordered_map: " << reference << " in " << slowSecs << " s" << endl;
+        cout << "Sharded, 4 threads:          " << (results[0] == reference ? "ok" : "MISMATCH") << " in " << sharedSecs
+             << " s, " << sharedStats.entries << " entries, hit rate " << sharedStats.hitRate() << endl;
+    }
+
     // --- TEST 2: 0/1 Knapsack ---
     // Items: {Weight, Value} -> {1, 4}, {3, 9}, {4, 10}
     vector<int> weights = {1, 3, 4, 5};
@@ -165,6 +489,41 @@ int main() {
     int capacity = 7;
     cout << "\n--- 2. Knapsack (Capacity 7) ---" << endl;
     cout << "Max Value: " << solver.knapsack(capacity, weights, values) << endl;
+    cout << "Items taken:";
+    for (int i : solver.knapsackItems(capacity, weights, values)) cout << " " << i; // Expect 1 2 (3 + 4 = 7, value 9)
+    cout << endl;
+    cout << "Some subset weighs exactly 2? " << (solver.canReachSum(2, weights) ? "yes" : "no") << endl;
+
+    // --- TEST 2b: Capacity 10^7 (the 2D table would need 4 GB) ---
+    {
+        mt19937 rng(7);
+        int bigW = 10000000;
+        vector<int> bigWeights(100), bigValues(100);
+        for (int i = 0; i < 100; i++) {
+            bigWeights[i] = 100000 + rng() % 400000;
+            bigValues[i] = 1 + rng() % 1000;
+        }
+        auto start = chrono::steady_clock::now();
+        int best = solver.knapsack(bigW, bigWeights, bigValues);
+        double rollSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        vector<int> picked = solver.knapsackItems(bigW, bigWeights, bigValues);
+        double pickSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        long long pickedWeight = 0, pickedValue = 0;
+        for (int i : picked) { pickedWeight += bigWeights[i]; pickedValue += bigValues[i]; }
+
+        start = chrono::steady_clock::now();
+        bool reachable = solver.canReachSum(bigW, bigWeights);
+        double bitSecs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << "\n--- 2b. Knapsack, 100 items, W = 10^7 ---" << endl;
+        cout << "Rolling 1D:     " << best << " in " << rollSecs << " s" << endl;
+        cout << "Reconstruction: " << picked.size() << " items, value " << pickedValue << ", weight "
+             << pickedWeight << (pickedValue == best && pickedWeight <= bigW ? " (ok)" : " (MISMATCH)")
+             << " in " << pickSecs << " s" << endl;
+        cout << "Subset weighing exactly W: " << (reachable ? "yes" : "no") << " in " << bitSecs << " s" << endl;
+    }
 
     // --- TEST 3: LCS ---
     string s1 = "abcde";
@@ -172,11 +531,45 @@ int main() {
     cout << "\n--- 3. Longest Common Subsequence ---" << endl;
     cout << "LCS of '" << s1 << "' & '" << s2 << "': " 
          << solver.longestCommonSubsequence(s1, s2) << endl; // Expect 3 ("ace")
+    cout << "Space optimized: " << solver.lcsSpaceOpt(s1, s2) << endl;
+    cout << "Bit-parallel:    " << solver.lcsBitParallel(s1, s2) << endl;
 
     // --- TEST 4: LIS ---
     vector<int> arr = {10, 9, 2, 5, 3, 7, 101, 18};
     cout << "\n--- 4. Longest Increasing Subsequence ---" << endl;
     cout << "LIS Length: " << solver.lengthOfLIS(arr) << endl; // Expect 4 (2, 3, 7, 18)
+    cout << "Quadratic:  " << solver.lengthOfLISQuadratic(arr) << endl;
+    cout << "One LIS:   ";
+    for (int x : solver.longestIncreasingSubsequence(arr)) cout << " " << x; // 2 3 7 18
+    cout << endl;
+
+    vector<int> repeats = {3, 1, 2, 2, 2, 5, 4, 4};
+    cout << "Non-decreasing in {3, 1, 2, 2, 2, 5, 4, 4}:";
+    for (int x : solver.longestIncreasingSubsequence(repeats, true)) cout << " " << x; // 1 2 2 2 4 4
+    cout << endl;
+
+    // Online: the answer is known after every element
+    StreamingLIS online;
+    cout << "Online lengths:";
+    for (int x : arr) {
+        online.push(x);
+        cout << " " << online.length();
+    }
+    cout << endl;
+
+    // --- TEST 4b: 10^6 elements ---
+    {
+        mt19937 rng(11);
+        vector<int> big(1000000);
+        for (int& x : big) x = rng() % 1000000000;
+        auto start = chrono::steady_clock::now();
+        vector<int> seq = solver.longestIncreasingSubsequence(big);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        bool increasing = is_sorted(seq.begin(), seq.end()) && adjacent_find(seq.begin(), seq.end()) == seq.end();
+        cout << "\n--- 4b. LIS of 10^6 Random Values ---" << endl;
+        cout << "Length " << seq.size() << (increasing && (int)seq.size() == solver.lengthOfLIS(big) ? " (ok)" : " (MISMATCH)")
+             << ", reconstructed in " << secs << " s" << endl;
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -4,9 +4,263 @@
 #include <unordered_set>
 #include <string>
 #include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#ifdef __SSE2__
+#include <emmintrin.h> // In-register scans
+#endif
 
 using namespace std;
 
+// ==========================================
+// ROLLING HASH ENGINE (Multi-Pattern Rabin-Karp)
+// Modulus 2^61 - 1 (a Mersenne prime): reduction is a shift and an add, and
+// with a random base two different windows collide with probability about
+// m / 2^61, so verification almost never runs on a non-match.
+// ==========================================
+class RollingHash61 {
+public:
+    static constexpr uint64_t MOD = (1ULL << 61) - 1;
+
+    static uint64_t mulMod(uint64_t a, uint64_t b) {
+        unsigned __int128 p = (unsigned __int128)a * b;
+        uint64_t r = (uint64_t)(p & MOD) + (uint64_t)(p >> 61);
+        return r >= MOD ? r - MOD : r;
+    }
+
+    static uint64_t addMod(uint64_t a, uint64_t b) {
+        uint64_t r = a + b;
+        return r >= MOD ? r - MOD : r;
+    }
+
+    // Random base per process: an adversary can't precompute colliding inputs
+    static uint64_t randomBase() {
+        static const uint64_t base = [] {
+            random_device rd;
+            uint64_t b = ((uint64_t)rd() << 32) ^ rd();
+            return 256 + b % (MOD - 512);
+        }();
+        return base;
+    }
+
+    static uint64_t hashOf(string_view s, uint64_t base) {
+        uint64_t h = 0;
+        for (unsigned char c : s) h = addMod(mulMod(h, base), c + 1);
+        return h;
+    }
+};
+
+// Finds every occurrence of many same-length patterns in one pass.
+// Each window's hash is looked up in a table of pattern hashes, so the cost
+// per byte is one rolling update and one hash probe, however many patterns.
+// Text may arrive in chunks: the last m bytes are kept in a ring buffer, so
+// matches that straddle chunk boundaries are found and offsets are absolute.
+class MultiPatternMatcher {
+public:
+    explicit MultiPatternMatcher(const vector<string>& pats)
+        : patterns(pats), base(RollingHash61::randomBase()) {
+        if (patterns.empty()) throw invalid_argument("MultiPatternMatcher: no patterns");
+        m = patterns[0].size();
+        if (m == 0) throw invalid_argument("MultiPatternMatcher: empty pattern");
+
+        byHash.reserve(patterns.size() * 2);
+        for (int id = 0; id < (int)patterns.size(); id++) {
+            if (patterns[id].size() != m) throw invalid_argument("MultiPatternMatcher: patterns must share one length");
+            byHash[RollingHash61::hashOf(patterns[id], base)].push_back(id);
+        }
+
+        // Weight of the byte leaving the window: base^(m-1)
+        outWeight = 1;
+        for (size_t i = 0; i + 1 < m; i++) outWeight = RollingHash61::mulMod(outWeight, base);
+        ring.assign(m, 0);
+    }
+
+    // Streams one chunk. onMatch(offset, patternId) is called for every match,
+    // with 'offset' counted from the start of the whole stream.
+    template <typename Callback>
+    void feed(string_view chunk, Callback&& onMatch) {
+        for (unsigned char c : chunk) {
+            size_t slot = pos % m;
+            if (pos >= m) {
+                // Remove the leading char, shift left, add the trailing one
+                uint64_t out = RollingHash61::mulMod(ring[slot] + 1, outWeight);
+                windowHash = RollingHash61::addMod(windowHash, RollingHash61::MOD - out);
+            }
+            windowHash = RollingHash61::addMod(RollingHash61::mulMod(windowHash, base), c + 1);
+            ring[slot] = c;
+            pos++;
+
+            if (pos >= m) {
+                auto it = byHash.find(windowHash);
+                if (it != byHash.end()) {
+                    for (int id : it->second) {
+                        if (windowEquals(patterns[id])) onMatch(pos - m, id);
+                    }
+                }
+            }
+        }
+    }
+
+    // Whole-text convenience wrapper: all (offset, patternId) pairs
+    vector<pair<size_t, int>> findAll(string_view text) {
+        reset();
+        vector<pair<size_t, int>> matches;
+        feed(text, [&](size_t offset, int id) { matches.emplace_back(offset, id); });
+        return matches;
+    }
+
+    void reset() {
+        pos = 0;
+        windowHash = 0;
+    }
+
+private:
+    vector<string> patterns;
+    unordered_map<uint64_t, vector<int>> byHash; // Pattern hash -> pattern ids
+    size_t m = 0;
+    uint64_t base;
+    uint64_t outWeight = 1;
+
+    // Streaming state
+    vector<unsigned char> ring; // Last m bytes; the window starts at pos % m
+    size_t pos = 0;             // Bytes consumed so far
+    uint64_t windowHash = 0;
+
+    // Byte-compare the current window against a candidate (rules out the
+    // astronomically rare hash collision)
+    bool windowEquals(const string& p) const {
+        size_t start = pos % m;
+        for (size_t j = 0; j < m; j++) {
+            if (ring[(start + j) % m] != (unsigned char)p[j]) return false;
+        }
+        return true;
+    }
+};
+
+// ==========================================
+// SCAN ENGINE (Prefix Sums)
+// inclusive: out[i] = in[0] op ... op in[i]
+// exclusive: out[i] = identity op in[0] op ... op in[i-1]
+// Works for any associative 'op'. Large inputs use a two-pass block scan:
+//   pass 1: every thread reduces its block to one total
+//   (serial): exclusive scan of the few block totals -> each block's carry-in
+//   pass 2: every thread scans its block starting from its carry-in
+// For plus<int> / plus<long long> the per-block scan runs in SSE2 registers
+// (log-step shifts within a vector, then one add of the running carry).
+// ==========================================
+class ScanEngine {
+public:
+    template <typename T, typename Op = plus<T>>
+    static void inclusiveScan(const T* in, T* out, size_t n, Op op = Op(), T identity = T(), unsigned threads = 0) {
+        run<false>(in, out, n, op, identity, threads);
+    }
+
+    template <typename T, typename Op = plus<T>>
+    static void exclusiveScan(const T* in, T* out, size_t n, Op op = Op(), T identity = T(), unsigned threads = 0) {
+        run<true>(in, out, n, op, identity, threads);
+    }
+
+    template <typename T, typename Op = plus<T>>
+    static vector<T> inclusive(const vector<T>& in, Op op = Op(), T identity = T(), unsigned threads = 0) {
+        vector<T> out(in.size());
+        inclusiveScan(in.data(), out.data(), in.size(), op, identity, threads);
+        return out;
+    }
+
+    template <typename T, typename Op = plus<T>>
+    static vector<T> exclusive(const vector<T>& in, Op op = Op(), T identity = T(), unsigned threads = 0) {
+        vector<T> out(in.size());
+        exclusiveScan(in.data(), out.data(), in.size(), op, identity, threads);
+        return out;
+    }
+
+private:
+    static constexpr size_t PARALLEL_THRESHOLD = 1 << 16;
+
+    template <bool Exclusive, typename T, typename Op>
+    static void run(const T* in, T* out, size_t n, Op op, T identity, unsigned threads) {
+        if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+        if (threads == 1 || n < PARALLEL_THRESHOLD) {
+            scanBlock<Exclusive>(in, out, n, op, identity);
+            return;
+        }
+
+        size_t chunk = (n + threads - 1) / threads;
+        vector<T> carry(threads, identity);
+        vector<thread> pool;
+
+        // Pass 1: block totals
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                size_t lo = min(n, t * chunk), hi = min(n, lo + chunk);
+                T total = identity;
+                for (size_t i = lo; i < hi; i++) total = op(total, in[i]);
+                carry[t] = total;
+            });
+        }
+        for (auto& th : pool) th.join();
+        pool.clear();
+
+        // Carry-in of each block = exclusive scan of the totals
+        T running = identity;
+        for (unsigned t = 0; t < threads; t++) {
+            T total = carry[t];
+            carry[t] = running;
+            running = op(running, total);
+        }
+
+        // Pass 2: scan each block from its carry-in
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                size_t lo = min(n, t * chunk), hi = min(n, lo + chunk);
+                scanBlock<Exclusive>(in + lo, out + lo, hi - lo, op, carry[t]);
+            });
+        }
+        for (auto& th : pool) th.join();
+    }
+
+    // Scans one contiguous block starting from 'carry'; in may equal out
+    template <bool Exclusive, typename T, typename Op>
+    static void scanBlock(const T* in, T* out, size_t n, Op op, T carry) {
+        size_t i = 0;
+#ifdef __SSE2__
+        if constexpr (is_same<Op, plus<T>>::value && is_integral<T>::value && sizeof(T) == 4) {
+            __m128i c = _mm_set1_epi32((int)carry);
+            for (; i + 4 <= n; i += 4) {
+                __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+                __m128i s = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                s = _mm_add_epi32(s, _mm_slli_si128(s, 8));
+                s = _mm_add_epi32(s, c);
+                c = _mm_shuffle_epi32(s, _MM_SHUFFLE(3, 3, 3, 3));
+                _mm_storeu_si128((__m128i*)(out + i), Exclusive ? _mm_sub_epi32(s, x) : s);
+            }
+            carry = (T)_mm_cvtsi128_si32(c);
+        } else if constexpr (is_same<Op, plus<T>>::value && is_integral<T>::value && sizeof(T) == 8) {
+            __m128i c = _mm_set1_epi64x((long long)carry);
+            for (; i + 2 <= n; i += 2) {
+                __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+                __m128i s = _mm_add_epi64(_mm_add_epi64(x, _mm_slli_si128(x, 8)), c);
+                c = _mm_unpackhi_epi64(s, s);
+                _mm_storeu_si128((__m128i*)(out + i), Exclusive ? _mm_sub_epi64(s, x) : s);
+            }
+            carry = (T)_mm_cvtsi128_si64(c);
+        }
+#endif
+        for (; i < n; i++) {
+            T x = in[i];
+            T next = op(carry, x);
+            out[i] = Exclusive ? carry : next;
+            carry = next;
+        }
+    }
+};
+
 class HashingMaster {
 public:
     // ==========================================
@@ -80,32 +334,118 @@ public:
         return count;
     }
 
+    // Parallel version for huge arrays (64-bit sums and count).
+    // Pairs (i, j) with Prefix[j] - Prefix[i] = k are independent of where
+    // they sit in the array, so after a parallel scan every prefix is sent
+    // to a hash partition twice: as a "source" keyed by Prefix[i] and as a
+    // "query" keyed by Prefix[j] - k. Matching keys meet in one partition,
+    // and each partition is counted by its own thread with a local map.
+    long long subarraySumEqualsKParallel(const vector<int>& nums, long long k, unsigned threads = 0) {
+        if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+        const size_t n = nums.size();
+
+        vector<long long> prefix(nums.begin(), nums.end());
+        ScanEngine::inclusiveScan(prefix.data(), prefix.data(), n, plus<long long>(), 0LL, threads);
+
+        struct Item { long long key; bool isQuery; };
+        const unsigned parts = threads;
+        auto partOf = [parts](long long v) {
+            return (unsigned)((((unsigned long long)v * 0x9E3779B97F4A7C15ULL) >> 32) % parts);
+        };
+
+        // Items in index order: source(0) for the empty prefix, then for every
+        // j a query before its source, so a prefix never pairs with itself.
+        size_t chunk = (n + threads - 1) / threads;
+        vector<vector<size_t>> counts(threads, vector<size_t>(parts, 0));
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                size_t lo = min(n, t * chunk), hi = min(n, lo + chunk);
+                for (size_t j = lo; j < hi; j++) {
+                    counts[t][partOf(prefix[j] - k)]++;
+                    counts[t][partOf(prefix[j])]++;
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        pool.clear();
+
+        vector<size_t> partStart(parts + 1, 0);
+        vector<vector<size_t>> offsets(threads, vector<size_t>(parts, 0));
+        size_t running = 0;
+        for (unsigned p = 0; p < parts; p++) {
+            partStart[p] = running;
+            if (p == partOf(0)) running++; // Slot for the empty-prefix source
+            for (unsigned t = 0; t < threads; t++) {
+                offsets[t][p] = running;
+                running += counts[t][p];
+            }
+        }
+        partStart[parts] = running;
+
+        vector<Item> items(running);
+        items[partStart[partOf(0)]] = {0, false};
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                size_t lo = min(n, t * chunk), hi = min(n, lo + chunk);
+                vector<size_t> pos = offsets[t];
+                for (size_t j = lo; j < hi; j++) {
+                    items[pos[partOf(prefix[j] - k)]++] = {prefix[j] - k, true};
+                    items[pos[partOf(prefix[j])]++] = {prefix[j], false};
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        pool.clear();
+
+        vector<long long> partCount(parts, 0);
+        for (unsigned p = 0; p < parts; p++) {
+            pool.emplace_back([&, p] {
+                unordered_map<long long, long long> seen;
+                seen.reserve((partStart[p + 1] - partStart[p]) / 2 + 1);
+                long long count = 0;
+                for (size_t i = partStart[p]; i < partStart[p + 1]; i++) {
+                    if (items[i].isQuery) {
+                        auto it = seen.find(items[i].key);
+                        if (it != seen.end()) count += it->second;
+                    } else {
+                        seen[items[i].key]++;
+                    }
+                }
+                partCount[p] = count;
+            });
+        }
+        for (auto& th : pool) th.join();
+
+        long long total = 0;
+        for (long long c : partCount) total += c;
+        return total;
+    }
+
     // ==========================================
     // PATTERN 3: ROLLING HASH (Rabin-Karp)
     // Use Case: "Find pattern in text", "Longest Duplicate Substring"
-    // Logic: Treat string as a base-26 number. Slide window and update hash in O(1).
+    // Logic: Treat string as a base-B number. Slide window and update hash in O(1).
     // Hash(new) = (Hash(old) - LeadingVal) * Base + TrailingVal
+    // With modulus 2^61 - 1 a false hash match is practically impossible; a
+    // small prime like 101 would make nearly every window "match".
     // ==========================================
-    int searchPatternRollingHash(string text, string pattern) {
+    int searchPatternRollingHash(string_view text, string_view pattern) {
         int n = text.length();
         int m = pattern.length();
         if (m > n) return -1;
+        if (m == 0) return 0;
 
-        long long pHash = 0; // Pattern hash
-        long long tHash = 0; // Text window hash
-        long long h = 1;     // The value of the most significant digit position
-        int base = 256;      // Alphabet size
-        int prime = 101;     // Prime number to reduce collisions
+        const uint64_t base = RollingHash61::randomBase();
+        uint64_t h = 1; // The value of the most significant digit position
 
-        // 1. Precompute 'h' = pow(base, m-1) % prime
+        // 1. Precompute 'h' = pow(base, m-1) % MOD
         for (int i = 0; i < m - 1; i++)
-            h = (h * base) % prime;
+            h = RollingHash61::mulMod(h, base);
 
         // 2. Calculate initial hashes
-        for (int i = 0; i < m; i++) {
-            pHash = (base * pHash + pattern[i]) % prime;
-            tHash = (base * tHash + text[i]) % prime;
-        }
+        uint64_t pHash = RollingHash61::hashOf(pattern, base);      // Pattern hash
+        uint64_t tHash = RollingHash61::hashOf(text.substr(0, m), base); // Text window hash
 
         // 3. Slide the window
         for (int i = 0; i <= n - m; i++) {
@@ -125,14 +465,23 @@ public:
             // Calculate hash for NEXT window
             if (i < n - m) {
                 // Remove leading char, shift left, add new trailing char
-                tHash = (base * (tHash - text[i] * h) + text[i + m]) % prime;
-
-                // Handle negative results from modulo arithmetic
-                if (tHash < 0) tHash = (tHash + prime);
+                // (chars are hashed as value + 1 so a leading '\0' still counts)
+                uint64_t lead = RollingHash61::mulMod((unsigned char)text[i] + 1, h);
+                tHash = RollingHash61::addMod(tHash, RollingHash61::MOD - lead);
+                tHash = RollingHash61::addMod(RollingHash61::mulMod(tHash, base), (unsigned char)text[i + m] + 1);
             }
         }
         return -1;
     }
+
+    // All start offsets of 'pattern' in 'text'
+    vector<size_t> searchAllRollingHash(string_view text, string_view pattern) {
+        if (pattern.empty()) return {};
+        MultiPatternMatcher matcher({string(pattern)});
+        vector<size_t> offsets;
+        for (auto& match : matcher.findAll(text)) offsets.push_back(match.first);
+        return offsets;
+    }
 };
 
 int main() {
@@ -153,11 +502,22 @@ int main() {
     int k = 3; 
     // Subarrays: [1,1,1] (indices 2-4) and [1,1,1] (indices 3-5)
     cout << "3. Subarrays with sum " << k << ": " << solver.subarraySumEqualsK(arr, k) << endl; 
+    cout << "   Parallel scan + partitioned count: " << solver.subarraySumEqualsKParallel(arr, k) << endl;
 
     // --- TEST 4: Rolling Hash ---
     string text = "GEEKS FOR GEEKS";
     string pat = "FOR";
     cout << "4. Pattern '" << pat << "' found at index: " << solver.searchPatternRollingHash(text, pat) << endl;
 
+    // --- TEST 5: Multi-Pattern Rolling Hash, streamed in chunks ---
+    // "GEEKS" straddles the chunk boundary below and must still be reported.
+    MultiPatternMatcher matcher({"GEEKS", "FOR G", "KS FO"});
+    vector<string> chunks = {"GEEKS FOR GE", "EKS"};
+    cout << "5. Multi-pattern matches (offset:pattern): ";
+    for (const string& chunk : chunks) {
+        matcher.feed(chunk, [](size_t offset, int id) { cout << offset << ":" << id << " "; });
+    }
+    cout << endl; // Expect 0:0 3:2 6:1 10:0
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,448 @@
+#ifndef MEMOIZE_H
+#define MEMOIZE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =================================================================
+// MEMOIZE: Reusable cache for top-down DP / recursion
+// Wraps a function so that each distinct argument tuple is computed once.
+//
+//   auto fib = memoize<long long(int)>([](auto& self, int n) -> long long {
+//       return n < 2 ? n : self(n - 1) + self(n - 2);
+//   });
+//   fib(90);
+//
+// The lambda receives the memoized wrapper as `self` and recurses through
+// it, so every call is a direct (inlinable) call: no std::function, no
+// virtual dispatch. Storage is picked by the factory:
+//   memoize        flat open-addressing hash map (any hashable args)
+//   memoizeDense   flat array for bounded integer args (fastest)
+//   memoizeLru     hash map + LRU list holding at most `capacity` results
+//   memoizeSharded mutex-striped hash map, callable from many threads
+// All keep hit / miss (and eviction) counters: stats().
+// Keys and results must be default-constructible and copyable.
+// =================================================================
+
+struct MemoStats {
+    uint64_t hits = 0, misses = 0, evictions = 0;
+    size_t entries = 0;
+
+    double hitRate() const { return hits + misses ? double(hits) / double(hits + misses) : 0.0; }
+};
+
+// --- Hashing argument tuples ---
+// std::hash<int> is the identity, which clusters badly in a power-of-two
+// table, so every value goes through the splitmix64 finalizer.
+inline uint64_t memoMix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+template <class T>
+struct MemoHash {
+    size_t operator()(const T& value) const { return size_t(memoMix(std::hash<T>{}(value))); }
+};
+
+// Fully mixing every argument would scatter neighbouring DP states such as
+// (r, c), (r, c - 1) and (r - 1, c) over the whole slot array, one cache
+// miss each. Instead the last two arguments are cut into 4 x 4 tiles: the
+// tile (and every earlier argument) is mixed and picks an aligned group of
+// 16 slots, the low 2 bits of each of the two arguments pick the slot in
+// it. Neighbours share a group 3 times in 4, while strided or sparse keys
+// still land in random groups, so linear probing does not cluster.
+template <class... T>
+struct MemoHash<std::tuple<T...>> {
+    size_t operator()(const std::tuple<T...>& key) const {
+        uint64_t h = sizeof...(T), prev = 0, last = 0;
+        std::apply([&](const T&... part) {
+            ((h = memoMix(h ^ prev), prev = last, last = uint64_t(std::hash<T>{}(part))), ...);
+        }, key);
+        h = memoMix(memoMix(h ^ (prev >> 2)) ^ (last >> 2));
+        return size_t(h << 4 | (prev & 3) << 2 | (last & 3));
+    }
+};
+
+// --- Flat hash map (open addressing, linear probing) ---
+// One contiguous slot array (no per-entry allocation) plus a byte array of
+// occupied flags, which stays cache-resident far longer than the slots.
+// Load factor stays <= 3/4; erase uses backward shifting, so there are no
+// tombstones.
+template <class K, class V, class Hash = MemoHash<K>>
+class FlatHashMap {
+public:
+    explicit FlatHashMap(size_t expected = 16) {
+        size_t capacity = 16;
+        while (capacity * 3 < expected * 4) capacity *= 2;
+        rehash(capacity);
+    }
+
+    V* find(const K& key) {
+        for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+            if (!used[i]) return nullptr;
+            if (slots[i].key == key) return &slots[i].value;
+        }
+    }
+
+    // An existing key keeps its value
+    V* insert(const K& key, V value) {
+        if ((count + 1) * 4 > slots.size() * 3) rehash(slots.size() * 2);
+        size_t i = hash(key) & mask;
+        for (; used[i]; i = (i + 1) & mask)
+            if (slots[i].key == key) return &slots[i].value;
+        used[i] = 1;
+        slots[i].key = key;
+        slots[i].value = std::move(value);
+        count++;
+        return &slots[i].value;
+    }
+
+    bool erase(const K& key) {
+        size_t i = hash(key) & mask;
+        for (; used[i]; i = (i + 1) & mask)
+            if (slots[i].key == key) break;
+        if (!used[i]) return false;
+
+        // Pull later entries of the cluster back unless that would move
+        // them before their home slot
+        for (size_t j = (i + 1) & mask; used[j]; j = (j + 1) & mask) {
+            size_t home = hash(slots[j].key) & mask;
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                slots[i] = std::move(slots[j]);
+                i = j;
+            }
+        }
+        used[i] = 0;
+        count--;
+        return true;
+    }
+
+    size_t size() const { return count; }
+
+    void clear() {
+        std::fill(used.begin(), used.end(), 0);
+        count = 0;
+    }
+
+private:
+    struct Slot {
+        K key;
+        V value;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint8_t> used;
+    size_t count = 0, mask = 0;
+    Hash hash;
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old = std::move(slots);
+        std::vector<uint8_t> oldUsed = std::move(used);
+        slots.assign(capacity, Slot());
+        used.assign(capacity, 0);
+        mask = capacity - 1;
+        count = 0;
+        for (size_t i = 0; i < old.size(); i++)
+            if (oldUsed[i]) insert(old[i].key, std::move(old[i].value));
+    }
+};
+
+// --- Storage policies ---
+// find() returns nullptr on a miss; insert() returns how many entries it
+// evicted to make room.
+
+template <class K, class V>
+class HashStore {
+public:
+    explicit HashStore(size_t expected = 16) : map(expected) {}
+
+    const V* find(const K& key) { return map.find(key); }
+    size_t insert(const K& key, const V& value) { map.insert(key, value); return 0; }
+    size_t size() const { return map.size(); }
+    void clear() { map.clear(); }
+
+private:
+    FlatHashMap<K, V> map;
+};
+
+// Key is a tuple of integers, argument i in [0, extents[i]); a key outside
+// the box is simply not cached
+template <class K, class V>
+class DenseStore {
+public:
+    static constexpr size_t Rank = std::tuple_size<K>::value;
+
+    explicit DenseStore(const std::array<size_t, Rank>& extents) : extents(extents) {
+        size_t cells = 1;
+        for (size_t e : extents) cells *= e;
+        values.assign(cells, V());
+        filled.assign(cells, 0);
+    }
+
+    const V* find(const K& key) {
+        size_t at;
+        return locate(key, at, std::make_index_sequence<Rank>()) && filled[at] ? &values[at] : nullptr;
+    }
+
+    size_t insert(const K& key, const V& value) {
+        size_t at;
+        if (locate(key, at, std::make_index_sequence<Rank>())) {
+            count += !filled[at];
+            values[at] = value;
+            filled[at] = 1;
+        }
+        return 0;
+    }
+
+    size_t size() const { return count; }
+
+    void clear() {
+        std::fill(filled.begin(), filled.end(), 0);
+        count = 0;
+    }
+
+private:
+    std::array<size_t, Rank> extents;
+    std::vector<V> values;
+    std::vector<uint8_t> filled;
+    size_t count = 0;
+
+    // Row-major index; a negative argument converts to a huge unsigned
+    // value, so one comparison checks both ends
+    template <size_t... I>
+    bool locate(const K& key, size_t& at, std::index_sequence<I...>) const {
+        bool inside = true;
+        at = 0;
+        ((inside = inside && uint64_t(std::get<I>(key)) < extents[I],
+          at = at * extents[I] + size_t(std::get<I>(key))), ...);
+        return inside;
+    }
+};
+
+// At most `capacity` results; a hit moves the entry to the front of an
+// index-linked list, a full insert evicts the back one
+template <class K, class V>
+class LruStore {
+public:
+    explicit LruStore(size_t capacity) : capacity(capacity ? capacity : 1), index(this->capacity) {
+        nodes.reserve(this->capacity);
+    }
+
+    const V* find(const K& key) {
+        uint32_t* at = index.find(key);
+        if (at == nullptr) return nullptr;
+        unlink(*at);
+        pushFront(*at);
+        return &nodes[*at].value;
+    }
+
+    size_t insert(const K& key, const V& value) {
+        if (uint32_t* at = index.find(key)) {
+            nodes[*at].value = value;
+            return 0;
+        }
+        uint32_t slot;
+        size_t evicted = 0;
+        if (nodes.size() < capacity) {
+            slot = uint32_t(nodes.size());
+            nodes.push_back(Node{ key, value, NIL, NIL });
+        } else {
+            slot = tail;
+            unlink(slot);
+            index.erase(nodes[slot].key);
+            nodes[slot].key = key;
+            nodes[slot].value = value;
+            evicted = 1;
+        }
+        pushFront(slot);
+        index.insert(key, slot);
+        return evicted;
+    }
+
+    size_t size() const { return nodes.size(); }
+
+    void clear() {
+        index.clear();
+        nodes.clear();
+        head = tail = NIL;
+    }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        K key;
+        V value;
+        uint32_t prev, next;
+    };
+
+    size_t capacity;
+    FlatHashMap<K, uint32_t> index;
+    std::vector<Node> nodes;
+    uint32_t head = NIL, tail = NIL;
+
+    void unlink(uint32_t i) {
+        Node& node = nodes[i];
+        (node.prev == NIL ? head : nodes[node.prev].next) = node.next;
+        (node.next == NIL ? tail : nodes[node.next].prev) = node.prev;
+        node.prev = node.next = NIL;
+    }
+
+    void pushFront(uint32_t i) {
+        nodes[i].next = head;
+        if (head != NIL) nodes[head].prev = i;
+        head = i;
+        if (tail == NIL) tail = i;
+    }
+};
+
+// --- Memoized function ---
+template <class Sig>
+struct MemoTraits;
+
+template <class R, class... Args>
+struct MemoTraits<R(Args...)> {
+    using Result = R;
+    using Key = std::tuple<std::decay_t<Args>...>;
+};
+
+template <class Sig, class F, class Store>
+class Memoized;
+
+template <class R, class... Args, class F, class Store>
+class Memoized<R(Args...), F, Store> {
+public:
+    using Key = typename MemoTraits<R(Args...)>::Key;
+
+    Memoized(F fn, Store store) : fn(std::move(fn)), store(std::move(store)) {}
+
+    R operator()(Args... args) {
+        Key key(args...);
+        if (const R* hit = store.find(key)) {
+            counters.hits++;
+            return *hit;
+        }
+        counters.misses++;
+        // Computed before inserting: the recursion may grow (rehash) the store
+        R value = fn(*this, args...);
+        counters.evictions += store.insert(key, value);
+        return value;
+    }
+
+    MemoStats stats() const {
+        MemoStats s = counters;
+        s.entries = store.size();
+        return s;
+    }
+
+    void clear() {
+        store.clear();
+        counters = MemoStats();
+    }
+
+private:
+    F fn;
+    Store store;
+    MemoStats counters;
+};
+
+// Thread-safe variant: the key's hash picks one of `shards` independently
+// locked hash maps, so threads mostly touch different locks. No lock is
+// held while computing (the function recurses into this same cache); two
+// threads missing the same key both compute it and the first insert wins.
+template <class Sig, class F>
+class ShardedMemo;
+
+template <class R, class... Args, class F>
+class ShardedMemo<R(Args...), F> {
+public:
+    using Key = typename MemoTraits<R(Args...)>::Key;
+
+    ShardedMemo(F fn, size_t shards) : fn(std::move(fn)) {
+        size_t count = 1;
+        while (count < shards) count *= 2;
+        this->shards.reset(new Shard[count]);
+        mask = count - 1;
+    }
+
+    R operator()(Args... args) {
+        Key key(args...);
+        Shard& shard = shards[(MemoHash<Key>{}(key) >> 40) & mask]; // Bits the map's probing does not start from
+        {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            if (const R* hit = shard.map.find(key)) {
+                shard.hits++;
+                return *hit;
+            }
+            shard.misses++;
+        }
+        R value = fn(*this, args...);
+        std::lock_guard<std::mutex> lock(shard.lock);
+        shard.map.insert(key, value);
+        return value;
+    }
+
+    MemoStats stats() const {
+        MemoStats s;
+        for (size_t i = 0; i <= mask; i++) {
+            std::lock_guard<std::mutex> lock(shards[i].lock);
+            s.hits += shards[i].hits;
+            s.misses += shards[i].misses;
+            s.entries += shards[i].map.size();
+        }
+        return s;
+    }
+
+private:
+    struct alignas(64) Shard { // One cache line per lock: no false sharing
+        mutable std::mutex lock;
+        FlatHashMap<Key, R> map;
+        uint64_t hits = 0, misses = 0;
+    };
+
+    F fn;
+    std::unique_ptr<Shard[]> shards;
+    size_t mask = 0;
+};
+
+// --- Factories: memoize<Result(Args...)>(lambda, ...) ---
+template <class Sig, class F>
+auto memoize(F fn, size_t expected = 16) {
+    using T = MemoTraits<Sig>;
+    using Store = HashStore<typename T::Key, typename T::Result>;
+    return Memoized<Sig, F, Store>(std::move(fn), Store(expected));
+}
+
+// One extent per argument: memoizeDense<int(int, int)>(fn, rows, cols)
+template <class Sig, class F, class... Extents>
+auto memoizeDense(F fn, Extents... extents) {
+    using T = MemoTraits<Sig>;
+    using Store = DenseStore<typename T::Key, typename T::Result>;
+    static_assert(sizeof...(Extents) == Store::Rank, "memoizeDense: one extent per argument");
+    return Memoized<Sig, F, Store>(std::move(fn), Store({ size_t(extents)... }));
+}
+
+template <class Sig, class F>
+auto memoizeLru(F fn, size_t capacity) {
+    using T = MemoTraits<Sig>;
+    using Store = LruStore<typename T::Key, typename T::Result>;
+    return Memoized<Sig, F, Store>(std::move(fn), Store(capacity));
+}
+
+template <class Sig, class F>
+auto memoizeSharded(F fn, size_t shards = 64) {
+    return ShardedMemo<Sig, F>(std::move(fn), shards);
+}
+
+#endif
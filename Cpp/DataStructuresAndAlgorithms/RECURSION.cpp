@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include "MEMOIZE.h"
 
 using namespace std;
 
@@ -51,6 +52,20 @@ public:
         return fibonacci(n - 1) + fibonacci(n - 2);
     }
 
+    // 2.1b Fibonacci + Memoization: O(n) instead of O(2^n)
+    // Same recursion, but each F(k) is computed once (MEMOIZE.h). Only the
+    // last few results are ever reused, so an LRU cache of 3 entries is
+    // enough: O(n) time with an O(1) cache.
+    long long fibonacciMemo(int n, MemoStats* stats = nullptr) {
+        auto fib = memoizeLru<long long(int)>([](auto& self, int k) -> long long {
+            if (k <= 1) return k;
+            return self(k - 1) + self(k - 2);
+        }, 3);
+        long long result = fib(n);
+        if (stats) *stats = fib.stats();
+        return result;
+    }
+
     // 2.2 Tower of Hanoi
     // Move N disks from Source(A) to Dest(C) using Aux(B)
     void towerOfHanoi(int n, char from, char to, char aux) {
@@ -129,6 +144,9 @@ int main() {
 
     cout << "\n--- 2. Tree Recursion (Fibonacci 6) ---" << endl;
     cout << "Fib(6): " << solver.fibonacci(6) << endl;
+    MemoStats fibStats;
+    cout << "Fib(90), memoized: " << solver.fibonacciMemo(90, &fibStats) << " (" << fibStats.misses << " misses, "
+         << fibStats.hits << " hits, " << fibStats.entries << " cached)" << endl;
 
     cout << "\n--- 3. Tower of Hanoi (3 Disks) ---" << endl;
     solver.towerOfHanoi(3, 'A', 'C', 'B');
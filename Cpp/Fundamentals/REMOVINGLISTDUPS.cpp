@@ -1,8 +1,583 @@
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#ifdef __SSE2__
+#include <emmintrin.h> // SSE2 register merges
+#endif
 
+// Open-addressing hash set for ints (linear probing, power-of-two capacity).
+// Sized up front from the expected element count so the hot loop never
+// allocates; it only grows if more keys arrive than were announced.
+class FlatIntSet {
+public:
+    explicit FlatIntSet(std::size_t expected = 16) {
+        std::size_t cap = 16;
+        while (cap < expected * 2) cap <<= 1; // keep load <= 0.5
+        reset(cap);
+    }
+
+    // Returns true if the key was newly added
+    bool insert(int key) {
+        if ((count + 1) * 2 > keys.size()) grow();
+        std::size_t i = slotFor(key);
+        while (used[i]) {
+            if (keys[i] == key) return false;
+            i = (i + 1) & mask;
+        }
+        used[i] = 1;
+        keys[i] = key;
+        count++;
+        return true;
+    }
+
+    bool contains(int key) const {
+        std::size_t i = slotFor(key);
+        while (used[i]) {
+            if (keys[i] == key) return true;
+            i = (i + 1) & mask;
+        }
+        return false;
+    }
+
+    std::size_t size() const { return count; }
+
+private:
+    std::vector<int> keys;
+    std::vector<std::uint8_t> used;
+    std::size_t mask = 0;
+    int shift = 0;
+    std::size_t count = 0;
+
+    void reset(std::size_t cap) {
+        keys.assign(cap, 0);
+        used.assign(cap, 0);
+        mask = cap - 1;
+        shift = 64;
+        while (cap > 1) { cap >>= 1; shift--; }
+        count = 0;
+    }
+
+    // Fibonacci hashing: the top bits of key * 2^64/phi are well mixed,
+    // so sequential and strided ids spread across the table.
+    std::size_t slotFor(int key) const {
+        std::uint64_t h = static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)) * 0x9E3779B97F4A7C15ULL;
+        return shift >= 64 ? 0 : static_cast<std::size_t>(h >> shift);
+    }
+
+    void grow() {
+        std::vector<int> oldKeys;
+        std::vector<std::uint8_t> oldUsed;
+        oldKeys.swap(keys);
+        oldUsed.swap(used);
+        reset(oldKeys.size() * 2);
+        for (std::size_t i = 0; i < oldKeys.size(); i++) {
+            if (oldUsed[i]) insert(oldKeys[i]);
+        }
+    }
+};
+
+enum class DedupMode {
+    Sorted,          // Unique values in ascending order (the original behaviour)
+    FirstOccurrence, // Unique values in input order, first occurrence wins
+    AlreadySorted,   // Input is sorted: a single unique() pass, no sort
+    Parallel         // FirstOccurrence, partitioned across threads
+};
+
+// Keeps the first occurrence of every value, preserving input order. O(n).
+std::vector<int> removeDuplicatesStable(const std::vector<int>& input) {
+    FlatIntSet seen(input.size());
+    std::vector<int> result;
+    result.reserve(input.size());
+    for (int num : input) {
+        if (seen.insert(num)) result.push_back(num);
+    }
+    return result;
+}
+
+// For input that is already sorted: one linear pass, no hashing at all.
+std::vector<int> removeDuplicatesSorted(const std::vector<int>& input) {
+    std::vector<int> result(input);
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+// Order-preserving dedup for very large vectors.
+// 1. Each thread scatters the indices of its chunk into P partitions by hash,
+//    so every distinct value lands in exactly one partition.
+// 2. Each partition is deduped independently (indices stay ascending, so the
+//    first index seen for a value is its first occurrence) and marks keepers.
+// 3. Keepers are compacted in parallel using per-chunk prefix counts.
+// Extra memory: one index per element plus one flag byte per element.
+std::vector<int> removeDuplicatesParallel(const std::vector<int>& input, unsigned threads = 0) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t n = input.size();
+    if (threads == 1 || n < (1u << 16)) return removeDuplicatesStable(input);
+
+    const unsigned P = threads;
+    const std::size_t chunk = (n + threads - 1) / threads;
+    auto partOf = [P](int v) {
+        std::uint64_t h = static_cast<std::uint64_t>(static_cast<std::uint32_t>(v)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<unsigned>((h >> 32) % P);
+    };
+
+    // Pass 1: per-chunk partition histograms
+    std::vector<std::vector<std::size_t>> counts(threads, std::vector<std::size_t>(P, 0));
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::size_t lo = std::min(n, t * chunk), hi = std::min(n, lo + chunk);
+            for (std::size_t i = lo; i < hi; i++) counts[t][partOf(input[i])]++;
+        });
+    }
+    for (auto& th : pool) th.join();
+    pool.clear();
+
+    // Offsets: partition-major, chunk-minor, so each partition's indices stay sorted
+    std::vector<std::vector<std::size_t>> offsets(threads, std::vector<std::size_t>(P, 0));
+    std::vector<std::size_t> partStart(P + 1, 0);
+    std::size_t running = 0;
+    for (unsigned p = 0; p < P; p++) {
+        partStart[p] = running;
+        for (unsigned t = 0; t < threads; t++) {
+            offsets[t][p] = running;
+            running += counts[t][p];
+        }
+    }
+    partStart[P] = running;
+
+    // Pass 2: scatter indices
+    std::vector<std::size_t> scattered(n);
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::size_t lo = std::min(n, t * chunk), hi = std::min(n, lo + chunk);
+            std::vector<std::size_t> pos = offsets[t];
+            for (std::size_t i = lo; i < hi; i++) scattered[pos[partOf(input[i])]++] = i;
+        });
+    }
+    for (auto& th : pool) th.join();
+    pool.clear();
+
+    // Pass 3: dedup each partition with its own flat set
+    std::vector<std::uint8_t> keep(n, 0);
+    for (unsigned p = 0; p < P; p++) {
+        pool.emplace_back([&, p] {
+            FlatIntSet seen(partStart[p + 1] - partStart[p]);
+            for (std::size_t k = partStart[p]; k < partStart[p + 1]; k++) {
+                std::size_t idx = scattered[k];
+                if (seen.insert(input[idx])) keep[idx] = 1;
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    pool.clear();
+    std::vector<std::size_t>().swap(scattered);
+
+    // Pass 4: parallel compaction
+    std::vector<std::size_t> kept(threads + 1, 0);
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::size_t lo = std::min(n, t * chunk), hi = std::min(n, lo + chunk);
+            std::size_t c = 0;
+            for (std::size_t i = lo; i < hi; i++) c += keep[i];
+            kept[t + 1] = c;
+        });
+    }
+    for (auto& th : pool) th.join();
+    pool.clear();
+    for (unsigned t = 0; t < threads; t++) kept[t + 1] += kept[t];
+
+    std::vector<int> result(kept[threads]);
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::size_t lo = std::min(n, t * chunk), hi = std::min(n, lo + chunk);
+            std::size_t out = kept[t];
+            for (std::size_t i = lo; i < hi; i++) {
+                if (keep[i]) result[out++] = input[i];
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    return result;
+}
+
+// Sorted unique values. sort + unique on a flat copy instead of building a
+// std::set, so there is one allocation rather than one per element.
 std::vector<int> removeDuplicates(const std::vector<int>& input) {
-    // A set automatically discards duplicates
-    std::set<int> uniqueSet(input.begin(), input.end());
-    return std::vector<int>(uniqueSet.begin(), uniqueSet.end());
-}
\ No newline at end of file
+    std::vector<int> result(input);
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::vector<int> removeDuplicates(const std::vector<int>& input, DedupMode mode) {
+    switch (mode) {
+        case DedupMode::FirstOccurrence: return removeDuplicatesStable(input);
+        case DedupMode::AlreadySorted:   return removeDuplicatesSorted(input);
+        case DedupMode::Parallel:        return removeDuplicatesParallel(input);
+        case DedupMode::Sorted:
+        default:                         return removeDuplicates(input);
+    }
+}
+
+// Streaming mode: reads whitespace-separated ints and writes each value the
+// first time it is seen (one per line). Memory is O(distinct), not O(input).
+// Returns the number of distinct values written.
+std::size_t removeDuplicatesStream(std::istream& in, std::ostream& out, std::size_t expectedDistinct = 1024) {
+    FlatIntSet seen(expectedDistinct);
+    int num;
+    while (in >> num) {
+        if (seen.insert(num)) out << num << '\n';
+    }
+    return seen.size();
+}
+
+// File wrapper around the streaming mode. Returns false if either file can't be opened.
+bool removeDuplicatesFile(const std::string& inPath, const std::string& outPath) {
+    std::ifstream in(inPath);
+    std::ofstream out(outPath);
+    if (!in || !out) return false;
+    removeDuplicatesStream(in, out);
+    return true;
+}
+
+// ==========================================
+// APPROXIMATE DISTINCT COUNTING
+// ==========================================
+// When the stream is too big to dedup exactly we only need "how many
+// distinct ids". Both sketches below are mergeable: shards can be built
+// independently (even on different machines) and combined afterwards.
+//
+// Error bounds (relative standard error of the estimate):
+//   HyperLogLog with 2^p registers : ~1.04 / sqrt(2^p)  (p = 14 -> ~0.81%)
+//   KMV keeping the k smallest hashes: ~1 / sqrt(k - 2)  (k = 4096 -> ~1.6%)
+// Both are exact-ish for tiny inputs: HLL switches to linear counting below
+// 2.5 * 2^p, KMV returns the exact count while it holds fewer than k hashes.
+// validateCardinalitySketches() checks these bounds empirically.
+
+// 64-bit finalizer (splitmix64): every input bit affects every output bit
+inline std::uint64_t sketchHash(int key) {
+    std::uint64_t x = static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)) + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Little-endian helpers for the serialization formats
+inline void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+inline void putU64(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+inline std::uint64_t getLE(const std::vector<std::uint8_t>& in, std::size_t& pos, int bytes) {
+    if (pos + bytes > in.size()) throw std::runtime_error("sketch: truncated input");
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= static_cast<std::uint64_t>(in[pos + i]) << (8 * i);
+    pos += bytes;
+    return v;
+}
+
+// Elementwise max of two register arrays (the HLL union). 16 lanes per SSE2 op.
+inline void mergeRegistersMax(std::uint8_t* dst, const std::uint8_t* src, std::size_t n) {
+    std::size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(a, b));
+    }
+#endif
+    for (; i < n; i++) dst[i] = std::max(dst[i], src[i]);
+}
+
+// HyperLogLog with a sparse representation for small cardinalities.
+// Sparse mode stores (index << 6 | rank) entries, so a sketch that has only
+// seen a few hundred ids costs a few hundred words instead of 2^p bytes.
+// Once the sparse list would outgrow the dense array it converts for good.
+class HyperLogLog {
+public:
+    explicit HyperLogLog(int precision = 14) : p(precision) {
+        if (p < 4 || p > 18) throw std::invalid_argument("HyperLogLog: precision must be in [4, 18]");
+        m = std::size_t(1) << p;
+    }
+
+    void add(int key) { addHash(sketchHash(key)); }
+
+    void addHash(std::uint64_t h) {
+        std::uint32_t idx = static_cast<std::uint32_t>(h >> (64 - p));
+        // Leading zeros of the remaining bits + 1; the sentinel bit caps the rank
+        std::uint64_t rest = (h << p) | (std::uint64_t(1) << (p - 1));
+        std::uint8_t rank = static_cast<std::uint8_t>(__builtin_clzll(rest) + 1);
+        if (dense) {
+            if (rank > registers[idx]) registers[idx] = rank;
+            return;
+        }
+        sparseBuffer.push_back((idx << 6) | rank);
+        if (sparseBuffer.size() >= sparseLimit()) compactSparse();
+    }
+
+    // Union: afterwards this sketch estimates |A u B|
+    void merge(const HyperLogLog& other) {
+        if (other.p != p) throw std::invalid_argument("HyperLogLog: precision mismatch");
+        if (!other.dense) {
+            for (std::uint32_t e : other.sparseBuffer) insertEncoded(e);
+            if (!dense && sparseBuffer.size() >= sparseLimit()) compactSparse();
+            return;
+        }
+        toDense();
+        mergeRegistersMax(registers.data(), other.registers.data(), m);
+    }
+
+    double estimate() const {
+        if (!dense) {
+            HyperLogLog copy(*this);
+            copy.toDense();
+            return copy.estimate();
+        }
+        double sum = 0.0;
+        std::size_t zeros = 0;
+        for (std::uint8_t r : registers) {
+            sum += std::ldexp(1.0, -r);
+            if (r == 0) zeros++;
+        }
+        double alpha = (m == 16) ? 0.673 : (m == 32) ? 0.697 : (m == 64) ? 0.709
+                     : 0.7213 / (1.0 + 1.079 / static_cast<double>(m));
+        double e = alpha * m * m / sum;
+        // Small-range correction: linear counting is far more accurate here.
+        // A 64-bit hash makes the large-range correction unnecessary.
+        if (e <= 2.5 * m && zeros != 0) e = m * std::log(static_cast<double>(m) / zeros);
+        return e;
+    }
+
+    bool isSparse() const { return !dense; }
+    int precision() const { return p; }
+    double standardError() const { return 1.04 / std::sqrt(static_cast<double>(m)); }
+
+    // Format: "HLL1" | u8 precision | u8 encoding (0 sparse, 1 dense) |
+    //         u32 count | count x (u32 sparse entry) or 2^p register bytes
+    std::vector<std::uint8_t> serialize() const {
+        HyperLogLog copy(*this);
+        if (!copy.dense) copy.compactSparse();
+        std::vector<std::uint8_t> out = {'H', 'L', 'L', '1',
+                                         static_cast<std::uint8_t>(p),
+                                         static_cast<std::uint8_t>(copy.dense ? 1 : 0)};
+        if (copy.dense) {
+            putU32(out, static_cast<std::uint32_t>(m));
+            out.insert(out.end(), copy.registers.begin(), copy.registers.end());
+        } else {
+            putU32(out, static_cast<std::uint32_t>(copy.sparseBuffer.size()));
+            for (std::uint32_t e : copy.sparseBuffer) putU32(out, e);
+        }
+        return out;
+    }
+
+    static HyperLogLog deserialize(const std::vector<std::uint8_t>& in) {
+        if (in.size() < 10 || std::memcmp(in.data(), "HLL1", 4) != 0)
+            throw std::runtime_error("HyperLogLog: bad magic");
+        HyperLogLog h(in[4]);
+        std::size_t pos = 6;
+        std::uint32_t count = static_cast<std::uint32_t>(getLE(in, pos, 4));
+        if (in[5] == 1) {
+            if (count != h.m || pos + count != in.size()) throw std::runtime_error("HyperLogLog: bad register block");
+            h.toDense();
+            std::memcpy(h.registers.data(), in.data() + pos, h.m);
+        } else if (in[5] == 0) {
+            for (std::uint32_t i = 0; i < count; i++) {
+                std::uint32_t e = static_cast<std::uint32_t>(getLE(in, pos, 4));
+                if ((e >> 6) >= h.m) throw std::runtime_error("HyperLogLog: bad sparse entry");
+                h.sparseBuffer.push_back(e);
+            }
+        } else {
+            throw std::runtime_error("HyperLogLog: unknown encoding");
+        }
+        return h;
+    }
+
+private:
+    int p;
+    std::size_t m;
+    bool dense = false;
+    std::vector<std::uint8_t> registers;
+    std::vector<std::uint32_t> sparseBuffer; // Encoded (idx << 6 | rank)
+
+    // A sparse entry costs 4 bytes, a dense register 1 byte
+    std::size_t sparseLimit() const { return m / 4; }
+
+    void insertEncoded(std::uint32_t e) {
+        if (dense) {
+            std::uint32_t idx = e >> 6;
+            std::uint8_t rank = static_cast<std::uint8_t>(e & 63);
+            if (rank > registers[idx]) registers[idx] = rank;
+        } else {
+            sparseBuffer.push_back(e);
+        }
+    }
+
+    // Sort, keep the max rank per index; go dense if still too large
+    void compactSparse() {
+        std::sort(sparseBuffer.begin(), sparseBuffer.end());
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < sparseBuffer.size(); i++) {
+            // Sorted order puts the highest rank of an index last
+            if (i + 1 < sparseBuffer.size() && (sparseBuffer[i + 1] >> 6) == (sparseBuffer[i] >> 6)) continue;
+            sparseBuffer[out++] = sparseBuffer[i];
+        }
+        sparseBuffer.resize(out);
+        if (sparseBuffer.size() * 2 >= sparseLimit()) toDense();
+    }
+
+    void toDense() {
+        if (dense) return;
+        registers.assign(m, 0);
+        dense = true;
+        for (std::uint32_t e : sparseBuffer) insertEncoded(e);
+        std::vector<std::uint32_t>().swap(sparseBuffer);
+    }
+};
+
+// K-Minimum-Values: keeps the k smallest distinct hashes. If the k-th
+// smallest is h_k (as a fraction of 2^64), the cardinality is ~(k-1)/h_k.
+// Unlike HLL it also supports set intersection estimates on the kept hashes.
+class KMVSketch {
+public:
+    explicit KMVSketch(std::size_t k = 4096) : k(k) {
+        if (k < 3) throw std::invalid_argument("KMVSketch: k must be >= 3");
+    }
+
+    void add(int key) { addHash(sketchHash(key)); }
+
+    void addHash(std::uint64_t h) {
+        if (mins.size() == k) {
+            if (h >= *mins.rbegin()) return; // The common fast path once warmed up
+            if (!mins.insert(h).second) return;
+            mins.erase(std::prev(mins.end()));
+        } else {
+            mins.insert(h);
+        }
+    }
+
+    void merge(const KMVSketch& other) {
+        if (other.k != k) throw std::invalid_argument("KMVSketch: k mismatch");
+        for (std::uint64_t h : other.mins) addHash(h);
+    }
+
+    double estimate() const {
+        if (mins.size() < k) return static_cast<double>(mins.size()); // Exact
+        double kth = std::ldexp(static_cast<double>(*mins.rbegin()), -64);
+        return (k - 1) / kth;
+    }
+
+    double standardError() const { return 1.0 / std::sqrt(static_cast<double>(k - 2)); }
+
+    // Format: "KMV1" | u32 k | u32 count | count x u64 hash (ascending)
+    std::vector<std::uint8_t> serialize() const {
+        std::vector<std::uint8_t> out = {'K', 'M', 'V', '1'};
+        putU32(out, static_cast<std::uint32_t>(k));
+        putU32(out, static_cast<std::uint32_t>(mins.size()));
+        for (std::uint64_t h : mins) putU64(out, h);
+        return out;
+    }
+
+    static KMVSketch deserialize(const std::vector<std::uint8_t>& in) {
+        if (in.size() < 12 || std::memcmp(in.data(), "KMV1", 4) != 0)
+            throw std::runtime_error("KMVSketch: bad magic");
+        std::size_t pos = 4;
+        KMVSketch s(static_cast<std::size_t>(getLE(in, pos, 4)));
+        std::uint32_t count = static_cast<std::uint32_t>(getLE(in, pos, 4));
+        if (count > s.k) throw std::runtime_error("KMVSketch: too many hashes");
+        for (std::uint32_t i = 0; i < count; i++) s.mins.insert(getLE(in, pos, 8));
+        return s;
+    }
+
+private:
+    std::size_t k;
+    std::set<std::uint64_t> mins; // At most k entries
+};
+
+// Multithreaded ingestion: each thread fills a private shard (no sharing,
+// no locks), then the shards are merged once at the end.
+template <typename Sketch>
+Sketch buildSketchParallel(const std::vector<int>& data, const Sketch& prototype, unsigned threads = 0) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Sketch> shards(threads, prototype);
+    std::vector<std::thread> pool;
+    const std::size_t chunk = (data.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            std::size_t lo = std::min(data.size(), t * chunk), hi = std::min(data.size(), lo + chunk);
+            for (std::size_t i = lo; i < hi; i++) shards[t].add(data[i]);
+        });
+    }
+    for (auto& th : pool) th.join();
+    Sketch result = prototype;
+    for (const Sketch& s : shards) result.merge(s);
+    return result;
+}
+
+// Validation harness for the documented error bounds. For each cardinality
+// the estimate must fall within 4 standard errors (a false alarm is ~1e-4),
+// and merge / serialization / parallel builds must agree with a serial build.
+bool validateCardinalitySketches(std::ostream& log = std::cout) {
+    bool ok = true;
+    auto check = [&](bool cond, const std::string& what) {
+        if (!cond) { log << "  FAIL: " << what << '\n'; ok = false; }
+    };
+
+    const int sizes[] = {10, 1000, 100000, 1000000};
+    for (int n : sizes) {
+        HyperLogLog hll(14);
+        KMVSketch kmv(4096);
+        for (int i = 0; i < n; i++) {
+            // Distinct, strided ids; unsigned so i * 7919 wraps instead of
+            // overflowing (7919 is odd, so the keys stay distinct mod 2^32)
+            int key = static_cast<int>(static_cast<unsigned>(i) * 7919u + 13u);
+            hll.add(key); hll.add(key); // Duplicates must not count
+            kmv.add(key);
+        }
+        double hErr = std::fabs(hll.estimate() - n) / n;
+        double kErr = std::fabs(kmv.estimate() - n) / n;
+        log << "  n=" << n << "  HLL err=" << hErr * 100 << "% (bound " << 4 * hll.standardError() * 100
+            << "%)  KMV err=" << kErr * 100 << "% (bound " << 4 * kmv.standardError() * 100 << "%)\n";
+        check(hErr <= 4 * hll.standardError(), "HLL error bound at n=" + std::to_string(n));
+        check(kErr <= 4 * kmv.standardError(), "KMV error bound at n=" + std::to_string(n));
+    }
+
+    // Merge of two halves == sketch of the whole (HLL registers are identical)
+    std::vector<int> data(200000);
+    for (std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<int>(i % 150000);
+    HyperLogLog whole(12), left(12), right(12);
+    KMVSketch kWhole(1024), kLeft(1024), kRight(1024);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        whole.add(data[i]); kWhole.add(data[i]);
+        if (i < data.size() / 2) { left.add(data[i]); kLeft.add(data[i]); }
+        else { right.add(data[i]); kRight.add(data[i]); }
+    }
+    left.merge(right);
+    kLeft.merge(kRight);
+    check(left.serialize() == whole.serialize(), "HLL merge equals whole");
+    check(kLeft.serialize() == kWhole.serialize(), "KMV merge equals whole");
+
+    // Serialization round trips (sparse and dense)
+    HyperLogLog small(14);
+    for (int i = 0; i < 50; i++) small.add(i);
+    check(small.isSparse(), "HLL stays sparse for small inputs");
+    check(HyperLogLog::deserialize(small.serialize()).serialize() == small.serialize(), "HLL sparse round trip");
+    check(HyperLogLog::deserialize(whole.serialize()).estimate() == whole.estimate(), "HLL dense round trip");
+    check(KMVSketch::deserialize(kWhole.serialize()).estimate() == kWhole.estimate(), "KMV round trip");
+
+    // Sharded parallel ingestion agrees with the serial build
+    check(buildSketchParallel(data, HyperLogLog(12), 4).serialize() == whole.serialize(), "HLL parallel build");
+    check(buildSketchParallel(data, KMVSketch(1024), 4).serialize() == kWhole.serialize(), "KMV parallel build");
+
+    log << (ok ? "Cardinality sketches: all checks passed\n" : "Cardinality sketches: FAILED\n");
+    return ok;
+}